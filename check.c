@@ -0,0 +1,308 @@
+#include "check.h"
+
+int check_add(struct check *, char *);
+int check_worker_create(struct check_worker *, struct check *);
+void check_worker_destroy(struct check_worker *);
+void * check_worker_run(void *);
+int check_script(struct check_worker *, struct check_script *);
+int check_undefined(struct check_worker *, struct check_script *);
+void check_print(struct check *);
+
+int check_create(struct check * check, size_t size, struct heap * heap, struct table * table) {
+    int status = 0;
+
+    size_t i;
+    struct map_kv kv;
+    struct item_node * item;
+    struct item_combo_node * combo;
+
+    check->table = table;
+    check->script = NULL;
+    check->count = 0;
+    check->item = NULL;
+    check->item_count = 0;
+    check->fail = 0;
+    atomic_init(&check->next, 0);
+    atomic_init(&check->status, 0);
+
+    if(store_create(&check->store, size)) {
+        status = panic("failed to create store object");
+    } else {
+        if(map_create(&check->map, (map_compare_cb) strcmp, heap->map_pool)) {
+            status = panic("failed to create map object");
+        } else {
+            /* identical scripts are checked once */
+            item = item_start(table);
+            while(item && !status) {
+                if(check_add(check, item->bonus)) {
+                    status = panic("failed to add check object");
+                } else {
+                    combo = item->combo;
+                    while(combo && !status) {
+                        if(check_add(check, combo->bonus))
+                            status = panic("failed to add check object");
+                        combo = combo->next;
+                    }
+                    check->item_count++;
+                    item = item_next(table);
+                }
+            }
+
+            if(status) {
+                /* skip */
+            } else if(!(check->script = calloc(check->count + 1, sizeof(*check->script)))) {
+                status = panic("out of memory");
+            } else if(!(check->item = calloc(check->item_count + 1, sizeof(*check->item)))) {
+                status = panic("out of memory");
+            } else {
+                i = 0;
+                kv = map_start(&check->map);
+                while(kv.key) {
+                    check->script[i++] = kv.value;
+                    kv = map_next(&check->map);
+                }
+
+                i = 0;
+                item = item_start(table);
+                while(item) {
+                    check->item[i++] = item;
+                    item = item_next(table);
+                }
+            }
+
+            if(status) {
+                free(check->item);
+                free(check->script);
+                map_destroy(&check->map);
+            }
+        }
+        if(status)
+            store_destroy(&check->store);
+    }
+
+    return status;
+}
+
+void check_destroy(struct check * check) {
+    free(check->item);
+    free(check->script);
+    map_destroy(&check->map);
+    store_destroy(&check->store);
+}
+
+int check_add(struct check * check, char * string) {
+    struct check_script * script;
+
+    if(map_search(&check->map, string))
+        return 0;
+
+    script = store_calloc(&check->store, sizeof(*script));
+    if(!script)
+        return panic("failed to calloc store object");
+
+    script->string = string;
+
+    if(map_insert(&check->map, string, script))
+        return panic("failed to insert map object");
+
+    check->count++;
+
+    return 0;
+}
+
+int check_run(struct check * check, size_t jobs) {
+    int status = 0;
+
+    size_t i;
+    size_t count;
+    struct check_worker * worker;
+
+    if(!jobs || jobs > CHECK_JOB_MAX)
+        return panic("invalid jobs - %zu", jobs);
+
+    worker = calloc(jobs, sizeof(*worker));
+    if(!worker)
+        return panic("out of memory");
+
+    for(count = 0; count < jobs && !status; count++)
+        if(check_worker_create(&worker[count], check))
+            status = panic("failed to create check worker object");
+
+    if(status)
+        count--;
+
+    for(i = 0; i < count; i++)
+        if(pthread_join(worker[i].thread, NULL))
+            status = panic("failed to join thread");
+
+    /* the results live in the workers' stores */
+    if(!status && !atomic_load(&check->status))
+        check_print(check);
+
+    for(i = 0; i < count; i++)
+        check_worker_destroy(&worker[i]);
+
+    free(worker);
+
+    if(atomic_load(&check->status))
+        status = panic("failed to check script");
+
+    return status;
+}
+
+int check_worker_create(struct check_worker * worker, struct check * check) {
+    int status = 0;
+
+    worker->check = check;
+
+    if(heap_create(&worker->heap, 4096)) {
+        status = panic("failed to create heap object");
+    } else if(script_create(&worker->script, 4096, &worker->heap, check->table)) {
+        status = panic("failed to create script object");
+        goto script_fail;
+    } else if(store_create(&worker->store, 4096)) {
+        status = panic("failed to create store object");
+        goto store_fail;
+    } else if(strbuf_create(&worker->strbuf, 4096)) {
+        status = panic("failed to create strbuf object");
+        goto strbuf_fail;
+    } else if(strbuf_create(&worker->buffer, 4096)) {
+        status = panic("failed to create strbuf object");
+        goto buffer_fail;
+    } else {
+        worker->script.check = 1;
+        if(pthread_create(&worker->thread, NULL, check_worker_run, worker)) {
+            status = panic("failed to create thread");
+            goto thread_fail;
+        }
+    }
+
+    return status;
+
+thread_fail:
+    strbuf_destroy(&worker->buffer);
+buffer_fail:
+    strbuf_destroy(&worker->strbuf);
+strbuf_fail:
+    store_destroy(&worker->store);
+store_fail:
+    script_destroy(&worker->script);
+script_fail:
+    heap_destroy(&worker->heap);
+
+    return status;
+}
+
+void check_worker_destroy(struct check_worker * worker) {
+    strbuf_destroy(&worker->buffer);
+    strbuf_destroy(&worker->strbuf);
+    store_destroy(&worker->store);
+    script_destroy(&worker->script);
+    heap_destroy(&worker->heap);
+}
+
+void * check_worker_run(void * context) {
+    struct check_worker * worker = context;
+    struct check * check = worker->check;
+    size_t index;
+
+    while(!atomic_load_explicit(&check->status, memory_order_relaxed)) {
+        index = atomic_fetch_add(&check->next, 1);
+        if(index >= check->count)
+            break;
+
+        if(check_script(worker, check->script[index])) {
+            panic("failed to check script - %s", check->script[index]->string);
+            atomic_store(&check->status, 1);
+        }
+    }
+
+    return NULL;
+}
+
+int check_script(struct check_worker * worker, struct check_script * script) {
+    int quiet;
+    int status;
+    char * reason;
+    size_t length;
+
+    undefined_clear(&worker->script.undefined);
+
+    /* the first panic of a failed script is its reason */
+    quiet = panic_quiet(1);
+    status = script_compile(&worker->script, script->string, &worker->strbuf);
+    panic_quiet(quiet);
+
+    if(status) {
+        reason = panic_reason();
+        length = strlen(reason);
+        while(length && (reason[length - 1] == '\n' || reason[length - 1] == '.'))
+            length--;
+
+        script->error = store_strcpy(&worker->store, reason, length);
+        if(!script->error)
+            return panic("failed to strcpy store object");
+    }
+
+    return check_undefined(worker, script);
+}
+
+int check_undefined(struct check_worker * worker, struct check_script * script) {
+    struct map_kv kv;
+
+    kv = map_start(&worker->script.undefined.map);
+    if(kv.key) {
+        strbuf_clear(&worker->buffer);
+        while(kv.key) {
+            if(strbuf_printf(&worker->buffer, " %s", (char *) kv.key))
+                return panic("failed to printf strbuf object");
+            kv = map_next(&worker->script.undefined.map);
+        }
+
+        script->undefined = store_strcpy(&worker->store, worker->buffer.buf, worker->buffer.pos - worker->buffer.buf);
+        if(!script->undefined)
+            return panic("failed to strcpy store object");
+    }
+
+    return 0;
+}
+
+void check_print(struct check * check) {
+    size_t i;
+    char * error;
+    struct item_node * item;
+    struct item_combo_node * combo;
+    struct check_script * script;
+
+    for(i = 0; i < check->item_count; i++) {
+        item = check->item[i];
+
+        script = map_search(&check->map, item->bonus);
+        error = script->error;
+        if(script->error || script->undefined) {
+            fprintf(stdout, "- id: %ld\n", item->id);
+            if(script->error)
+                fprintf(stdout, "  error: %s\n", script->error);
+            if(script->undefined)
+                fprintf(stdout, "  undefined:%s\n", script->undefined);
+        }
+
+        combo = item->combo;
+        while(combo) {
+            script = map_search(&check->map, combo->bonus);
+            if(!error)
+                error = script->error;
+            if(script->error || script->undefined) {
+                fprintf(stdout, "- id: %ld\n  combo: %s\n", item->id, combo->combo);
+                if(script->error)
+                    fprintf(stdout, "  error: %s\n", script->error);
+                if(script->undefined)
+                    fprintf(stdout, "  undefined:%s\n", script->undefined);
+            }
+            combo = combo->next;
+        }
+
+        if(error)
+            check->fail++;
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef check_h
+#define check_h
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "script.h"
+
+#define CHECK_JOB_MAX 64
+
+struct check_script {
+    char * string;
+    char * error;
+    char * undefined;
+};
+
+struct check {
+    struct table * table;
+    struct store store;
+    struct map map;
+    struct check_script ** script;
+    size_t count;
+    struct item_node ** item;
+    size_t item_count;
+    atomic_size_t next;
+    atomic_int status;
+    size_t fail;
+};
+
+struct check_worker {
+    struct check * check;
+    struct heap heap;
+    struct script script;
+    struct store store;
+    struct strbuf strbuf;
+    struct strbuf buffer;
+    pthread_t thread;
+};
+
+int check_create(struct check *, size_t, struct heap *, struct table *);
+void check_destroy(struct check *);
+int check_run(struct check *, size_t);
+
+#endif
@@ -5,18 +5,17 @@
 int csv_parse(const char * path, csv_cb cb, void * arg) {
     int status = 0;
 
-    FILE * file;
     yyscan_t scanner;
     struct csv csv;
 
-    file = fopen(path, "r");
-    if(!file) {
+    csv.file = input_open(path);
+    if(!csv.file) {
         status = panic("failed to open %s", path);
     } else {
         if(csvlex_init_extra(&csv, &scanner)) {
             status = panic("failed to create scanner object");
         } else {
-            csvrestart(file, scanner);
+            csvrestart(NULL, scanner);
 
             csv.index = 0;
             csv.cb = cb;
@@ -27,7 +26,35 @@ int csv_parse(const char * path, csv_cb cb, void * arg) {
 
             csvlex_destroy(scanner);
         }
-        fclose(file);
+        input_close(csv.file);
+    }
+
+    return status;
+}
+
+int csv_parse_bytes(const char * string, size_t length, csv_cb cb, void * arg) {
+    int status = 0;
+
+    yyscan_t scanner;
+    struct csv csv;
+
+    csv.file = NULL;
+
+    if(csvlex_init_extra(&csv, &scanner)) {
+        status = panic("failed to create scanner object");
+    } else {
+        if(!csv_scan_bytes(string, length, scanner)) {
+            status = panic("failed to scan bytes");
+        } else {
+            csv.index = 0;
+            csv.cb = cb;
+            csv.arg = arg;
+
+            if(csvlex(scanner))
+                status = panic("failed to parse bytes");
+        }
+
+        csvlex_destroy(scanner);
     }
 
     return status;
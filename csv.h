@@ -2,6 +2,7 @@
 #define csv_h
 
 #include "array.h"
+#include "input.h"
 
 enum csv_event {
     csv_start,
@@ -12,11 +13,13 @@ enum csv_event {
 typedef int (* csv_cb) (enum csv_event, int, struct string *, void *);
 
 struct csv {
+    gzFile file;
     int index;
     csv_cb cb;
     void * arg;
 };
 
 int csv_parse(const char *, csv_cb, void *);
+int csv_parse_bytes(const char *, size_t, csv_cb, void *);
 
 #endif
@@ -0,0 +1,328 @@
+#include "emit.h"
+
+int emit_yaml_item(struct emit *, struct item_node *);
+int emit_yaml_bonus(struct emit *, char *);
+int emit_yaml_combo(struct emit *, char *, char *);
+int emit_yaml_end(struct emit *);
+int emit_yaml_line(struct emit *, char *, char *);
+
+int emit_ndjson_item(struct emit *, struct item_node *);
+int emit_ndjson_bonus(struct emit *, char *);
+int emit_ndjson_combo(struct emit *, char *, char *);
+int emit_ndjson_end(struct emit *);
+int emit_ndjson_string(struct emit *, char *, size_t);
+int emit_ndjson_line(struct emit *, char *);
+
+struct emit_backend emit_list[] = {
+    { "yaml", "yml", emit_yaml_item, emit_yaml_bonus, emit_yaml_combo, emit_yaml_end },
+    { "ndjson", "ndjson", emit_ndjson_item, emit_ndjson_bonus, emit_ndjson_combo, emit_ndjson_end },
+    { NULL, NULL, NULL, NULL, NULL, NULL }
+};
+
+struct emit_backend * emit_backend(char * identifier) {
+    struct emit_backend * backend;
+
+    backend = emit_list;
+    while(backend->identifier) {
+        if(!strcmp(backend->identifier, identifier))
+            return backend;
+        backend++;
+    }
+
+    return NULL;
+}
+
+int emit_create(struct emit * emit, struct ring * ring, struct emit_backend * backend) {
+    int status = 0;
+
+    if(!ring) {
+        status = panic("invalid ring object");
+    } else if(!backend) {
+        status = panic("invalid backend object");
+    } else {
+        emit->buffer = ring_acquire(ring);
+        if(!emit->buffer) {
+            status = panic("failed to acquire ring object");
+        } else {
+            emit->ring = ring;
+            emit->size = ring->size;
+            emit->length = 0;
+            emit->offset = 0;
+            emit->anchor = 0;
+            emit->combo = 0;
+            emit->id = 0;
+            emit->backend = backend;
+            emit->sidecar = NULL;
+        }
+    }
+
+    return status;
+}
+
+void emit_destroy(struct emit * emit) {
+    emit->buffer = NULL;
+}
+
+int emit_flush(struct emit * emit) {
+    if(emit->length) {
+        if(ring_publish(emit->ring, emit->length))
+            return panic("failed to publish ring object");
+        emit->offset += emit->length;
+        emit->length = 0;
+
+        emit->buffer = ring_acquire(emit->ring);
+        if(!emit->buffer)
+            return panic("failed to acquire ring object");
+    }
+
+    return 0;
+}
+
+int emit_write(struct emit * emit, char * string, size_t length) {
+    size_t size;
+
+    while(length) {
+        if(emit->length == emit->size && emit_flush(emit))
+            return panic("failed to flush emit object");
+
+        size = emit->size - emit->length;
+        if(size > length)
+            size = length;
+
+        memcpy(emit->buffer + emit->length, string, size);
+        emit->length += size;
+        string += size;
+        length -= size;
+    }
+
+    return 0;
+}
+
+int emit_putc(struct emit * emit, char c) {
+    if(emit->length == emit->size && emit_flush(emit))
+        return panic("failed to flush emit object");
+
+    emit->buffer[emit->length++] = c;
+
+    return 0;
+}
+
+int emit_printf(struct emit * emit, char * format, ...) {
+    int status = 0;
+
+    int result;
+    va_list vararg;
+
+    va_start(vararg, format);
+    result = vsnprintf(emit->buffer + emit->length, emit->size - emit->length, format, vararg);
+    va_end(vararg);
+
+    if(result < 0) {
+        status = panic("failed to vsnprintf emit object");
+    } else if(result >= emit->size - emit->length) {
+        if(emit_flush(emit)) {
+            status = panic("failed to flush emit object");
+        } else {
+            va_start(vararg, format);
+            result = vsnprintf(emit->buffer, emit->size, format, vararg);
+            va_end(vararg);
+
+            if(result < 0 || result >= emit->size) {
+                status = panic("out of memory");
+            } else {
+                emit->length = result;
+            }
+        }
+    } else {
+        emit->length += result;
+    }
+
+    return status;
+}
+
+int emit_item(struct emit * emit, struct item_node * item) {
+    emit->combo = 0;
+    emit->id = item->id;
+    emit->anchor = emit->offset + emit->length;
+
+    return emit->backend->item(emit, item);
+}
+
+int emit_bonus(struct emit * emit, char * bonus) {
+    return emit->backend->bonus(emit, bonus);
+}
+
+int emit_combo(struct emit * emit, char * combo, char * bonus) {
+    if(emit->backend->combo(emit, combo, bonus))
+        return 1;
+
+    emit->combo++;
+
+    return 0;
+}
+
+int emit_end(struct emit * emit) {
+    if(emit->backend->end(emit))
+        return 1;
+
+    if(emit->sidecar && sidecar_add(emit->sidecar, emit->id, emit->anchor, emit->offset + emit->length - emit->anchor))
+        return panic("failed to add sidecar object");
+
+    return 0;
+}
+
+int emit_yaml_item(struct emit * emit, struct item_node * item) {
+    return emit_printf(
+        emit,
+        "- id: %ld\n"
+        "  name: %s\n",
+        item->id,
+        item->name
+    );
+}
+
+int emit_yaml_bonus(struct emit * emit, char * bonus) {
+    if(bonus && *bonus)
+        if(emit_printf(emit, "  bonus: |\n") || emit_yaml_line(emit, "    ", bonus))
+            return panic("failed to write emit object");
+
+    return 0;
+}
+
+int emit_yaml_combo(struct emit * emit, char * combo, char * bonus) {
+    if(!emit->combo && emit_printf(emit, "  combo:\n"))
+        return panic("failed to printf emit object");
+
+    if(emit_printf(emit, "    - |\n      [%s]\n", combo))
+        return panic("failed to printf emit object");
+
+    if(bonus && *bonus && emit_yaml_line(emit, "      ", bonus))
+        return panic("failed to write emit object");
+
+    return 0;
+}
+
+int emit_yaml_end(struct emit * emit) {
+    return 0;
+}
+
+int emit_yaml_line(struct emit * emit, char * indent, char * string) {
+    char * anchor;
+    char * cursor;
+    char * end;
+    size_t length;
+
+    length = strlen(indent);
+
+    anchor = string;
+    end = string + strlen(string);
+    cursor = memchr(anchor, '\n', end - anchor);
+    while(cursor) {
+        if( emit_write(emit, indent, length) ||
+            emit_write(emit, anchor, cursor - anchor + 1) )
+            return panic("failed to write emit object");
+        anchor = cursor + 1;
+        cursor = memchr(anchor, '\n', end - anchor);
+    }
+
+    if( emit_write(emit, indent, length) ||
+        emit_write(emit, anchor, end - anchor) ||
+        emit_putc(emit, '\n') )
+        return panic("failed to write emit object");
+
+    return 0;
+}
+
+int emit_ndjson_item(struct emit * emit, struct item_node * item) {
+    if(emit_printf(emit, "{\"id\":%ld,\"name\":", item->id))
+        return panic("failed to printf emit object");
+
+    return emit_ndjson_string(emit, item->name, strlen(item->name));
+}
+
+int emit_ndjson_bonus(struct emit * emit, char * bonus) {
+    if(emit_printf(emit, ",\"bonus\":"))
+        return panic("failed to printf emit object");
+
+    return emit_ndjson_line(emit, bonus);
+}
+
+int emit_ndjson_combo(struct emit * emit, char * combo, char * bonus) {
+    if(emit_printf(emit, emit->combo ? ",{\"name\":" : ",\"combo\":[{\"name\":"))
+        return panic("failed to printf emit object");
+
+    if(emit_ndjson_string(emit, combo, strlen(combo)))
+        return panic("failed to string emit object");
+
+    if(emit_printf(emit, ",\"bonus\":"))
+        return panic("failed to printf emit object");
+
+    if(emit_ndjson_line(emit, bonus))
+        return panic("failed to line emit object");
+
+    return emit_putc(emit, '}');
+}
+
+int emit_ndjson_end(struct emit * emit) {
+    if(emit->combo && emit_putc(emit, ']'))
+        return panic("failed to putc emit object");
+
+    return emit_write(emit, "}\n", 2);
+}
+
+int emit_ndjson_string(struct emit * emit, char * string, size_t length) {
+    size_t i;
+    unsigned char c;
+
+    if(emit_putc(emit, '"'))
+        return panic("failed to putc emit object");
+
+    for(i = 0; i < length; i++) {
+        c = string[i];
+        switch(c) {
+            case '"':  if(emit_write(emit, "\\\"", 2)) return 1; break;
+            case '\\': if(emit_write(emit, "\\\\", 2)) return 1; break;
+            case '\b': if(emit_write(emit, "\\b", 2)) return 1; break;
+            case '\f': if(emit_write(emit, "\\f", 2)) return 1; break;
+            case '\n': if(emit_write(emit, "\\n", 2)) return 1; break;
+            case '\r': if(emit_write(emit, "\\r", 2)) return 1; break;
+            case '\t': if(emit_write(emit, "\\t", 2)) return 1; break;
+            default:
+                if(c < 0x20) {
+                    if(emit_printf(emit, "\\u%04x", c))
+                        return 1;
+                } else if(emit_putc(emit, c)) {
+                    return 1;
+                }
+                break;
+        }
+    }
+
+    return emit_putc(emit, '"');
+}
+
+int emit_ndjson_line(struct emit * emit, char * string) {
+    char * anchor;
+    char * cursor;
+    char * end;
+
+    if(emit_putc(emit, '['))
+        return panic("failed to putc emit object");
+
+    if(string && *string) {
+        anchor = string;
+        end = string + strlen(string);
+        cursor = memchr(anchor, '\n', end - anchor);
+        while(cursor) {
+            if(emit_ndjson_string(emit, anchor, cursor - anchor) || emit_putc(emit, ','))
+                return panic("failed to string emit object");
+            anchor = cursor + 1;
+            cursor = memchr(anchor, '\n', end - anchor);
+        }
+
+        if(emit_ndjson_string(emit, anchor, end - anchor))
+            return panic("failed to string emit object");
+    }
+
+    return emit_putc(emit, ']');
+}
@@ -0,0 +1,49 @@
+#ifndef emit_h
+#define emit_h
+
+#include "table.h"
+#include "sidecar.h"
+#include "ring.h"
+
+struct emit;
+
+typedef int (* emit_item_cb) (struct emit *, struct item_node *);
+typedef int (* emit_bonus_cb) (struct emit *, char *);
+typedef int (* emit_combo_cb) (struct emit *, char *, char *);
+typedef int (* emit_end_cb) (struct emit *);
+
+struct emit_backend {
+    char * identifier;
+    char * extension;
+    emit_item_cb item;
+    emit_bonus_cb bonus;
+    emit_combo_cb combo;
+    emit_end_cb end;
+};
+
+struct emit {
+    struct ring * ring;
+    char * buffer;
+    size_t size;
+    size_t length;
+    size_t offset;
+    size_t anchor;
+    size_t combo;
+    long id;
+    struct emit_backend * backend;
+    struct sidecar * sidecar;
+};
+
+struct emit_backend * emit_backend(char *);
+int emit_create(struct emit *, struct ring *, struct emit_backend *);
+void emit_destroy(struct emit *);
+int emit_flush(struct emit *);
+int emit_write(struct emit *, char *, size_t);
+int emit_putc(struct emit *, char);
+int emit_printf(struct emit *, char *, ...);
+int emit_item(struct emit *, struct item_node *);
+int emit_bonus(struct emit *, char *);
+int emit_combo(struct emit *, char *, char *);
+int emit_end(struct emit *);
+
+#endif
@@ -0,0 +1,50 @@
+#include "input.h"
+
+gzFile input_open(const char * path) {
+    gzFile file;
+    size_t length;
+    char * string;
+
+    file = gzopen(path, "rb");
+    if(!file) {
+        /* fall back on the compressed snapshot */
+        length = strlen(path);
+        string = malloc(length + 4);
+        if(!string)
+            return NULL;
+
+        memcpy(string, path, length);
+        memcpy(string + length, ".gz", 4);
+        file = gzopen(string, "rb");
+        free(string);
+    }
+
+    if(file && gzbuffer(file, INPUT_BUFFER)) {
+        gzclose(file);
+        file = NULL;
+    }
+
+    return file;
+}
+
+int input_read(gzFile file, char * buffer, size_t size) {
+    int result;
+    int error;
+
+    result = gzread(file, buffer, size);
+    if(!result) {
+        /* end of file or truncated stream */
+        gzerror(file, &error);
+        if(error != Z_OK)
+            result = -1;
+    }
+
+    if(result < 0)
+        panic("failed to read input - %s", gzerror(file, &error));
+
+    return result;
+}
+
+void input_close(gzFile file) {
+    gzclose(file);
+}
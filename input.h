@@ -0,0 +1,18 @@
+#ifndef input_h
+#define input_h
+
+#include <zlib.h>
+
+#include "panic.h"
+
+#define INPUT_BUFFER 1048576
+
+gzFile input_open(const char *);
+int input_read(gzFile, char *, size_t);
+void input_close(gzFile);
+
+#define INPUT_SCANNER(buffer, result, size) \
+    if((result = input_read(yyextra->file, buffer, size)) < 0) \
+        YY_FATAL_ERROR("failed to read input");
+
+#endif
@@ -0,0 +1,29 @@
+#include "sidecar.h"
+
+int main(int argc, char ** argv) {
+    int status = 0;
+    struct sidecar_map map;
+
+    int i;
+    long id;
+    char * string;
+    size_t length;
+
+    if(argc < 4) {
+        status = panic("usage: %s output index id...", argv[0]);
+    } else if(sidecar_map_open(&map, argv[1], argv[2])) {
+        status = panic("failed to open sidecar map object");
+    } else {
+        for(i = 3; i < argc && !status; i++) {
+            id = strtol(argv[i], NULL, 0);
+            if(sidecar_map_find(&map, id, &string, &length)) {
+                status = panic("invalid item id - %s", argv[i]);
+            } else if(fwrite(string, 1, length, stdout) != length) {
+                status = panic("failed to write file object");
+            }
+        }
+        sidecar_map_close(&map);
+    }
+
+    return status;
+}
@@ -104,6 +104,8 @@ static inline void map_insert_node(struct map * map, struct map_node * x) {
         while(i) {
             p = i;
             c = map->compare(x->key, p->key);
+            if(!c)
+                break;
             i = 0 > c ? i->left : i->right;
         }
 
@@ -399,6 +401,23 @@ struct map_kv map_start(struct map * map) {
     return map_next(map);
 }
 
+struct map_kv map_lower(struct map * map, void * key) {
+    struct map_node * node;
+
+    map->iter = NULL;
+    node = map->root;
+    while(node) {
+        if(map->compare(key, node->key) > 0) {
+            node = node->right;
+        } else {
+            map->iter = node;
+            node = node->left;
+        }
+    }
+
+    return map_next(map);
+}
+
 struct map_kv map_next(struct map * map) {
     struct map_kv kv = { NULL, NULL };
     struct map_node * node;
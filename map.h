@@ -39,6 +39,7 @@ int map_insert(struct map *, void *, void *);
 int map_delete(struct map *, void *);
 void * map_search(struct map *, void *);
 struct map_kv map_start(struct map *);
+struct map_kv map_lower(struct map *, void *);
 struct map_kv map_next(struct map *);
 
 #endif
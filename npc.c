@@ -0,0 +1,538 @@
+#include "npc.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+int npc_walk(struct npc *, char *);
+int npc_add(struct npc *, char *);
+int npc_worker_create(struct npc_worker *, struct npc *);
+void npc_worker_destroy(struct npc_worker *);
+void * npc_worker_run(void *);
+int npc_file(struct npc_worker *, char *);
+int npc_read(char *, char **, size_t *);
+int npc_fresh(char *, uint64_t);
+int npc_mkdir(char *);
+int npc_translate(struct npc_worker *, char *, size_t);
+int npc_block(struct npc_worker *, char *, char *, size_t, size_t);
+uint64_t npc_hash(char *, size_t);
+
+int npc_create(struct npc * npc, size_t size, struct table * table, char * source, char * output) {
+    int status = 0;
+
+    if(!table) {
+        status = panic("invalid table object");
+    } else if(!source || !output) {
+        status = panic("invalid path");
+    } else if(store_create(&npc->store, size)) {
+        status = panic("failed to create store object");
+    } else {
+        npc->table = table;
+        npc->source = source;
+        npc->output = output;
+        npc->root = NULL;
+        npc->file = NULL;
+        npc->count = 0;
+        atomic_init(&npc->next, 0);
+        atomic_init(&npc->skip, 0);
+        atomic_init(&npc->block, 0);
+        atomic_init(&npc->status, 0);
+    }
+
+    return status;
+}
+
+void npc_destroy(struct npc * npc) {
+    store_destroy(&npc->store);
+}
+
+int npc_scan(struct npc * npc) {
+    size_t i;
+    struct npc_file * file;
+
+    if(npc_walk(npc, ""))
+        return panic("failed to walk npc object - %s", npc->source);
+
+    if(npc->count) {
+        npc->file = store_malloc(&npc->store, sizeof(*npc->file) * npc->count);
+        if(!npc->file)
+            return panic("failed to malloc store object");
+
+        file = npc->root;
+        for(i = 0; i < npc->count; i++) {
+            npc->file[i] = file;
+            file = file->next;
+        }
+    }
+
+    return 0;
+}
+
+int npc_walk(struct npc * npc, char * relative) {
+    int status = 0;
+
+    DIR * dir;
+    struct dirent * entry;
+    struct stat info;
+    char path[PATH_MAX];
+    char name[PATH_MAX];
+    char * string;
+
+    if(snprintf(path, sizeof(path), "%s/%s", npc->source, relative) >= sizeof(path))
+        return panic("invalid path - %s", relative);
+
+    dir = opendir(path);
+    if(!dir)
+        return panic("failed to open %s", path);
+
+    while(!status && (entry = readdir(dir))) {
+        if(entry->d_name[0] == '.') {
+            /* skip */
+        } else if(snprintf(name, sizeof(name), "%s%s%s", relative, *relative ? "/" : "", entry->d_name) >= sizeof(name)) {
+            status = panic("invalid path - %s", entry->d_name);
+        } else if(snprintf(path, sizeof(path), "%s/%s", npc->source, name) >= sizeof(path)) {
+            status = panic("invalid path - %s", name);
+        } else if(stat(path, &info)) {
+            status = panic("failed to stat %s", path);
+        } else if(S_ISDIR(info.st_mode)) {
+            string = store_strcpy(&npc->store, name, strlen(name));
+            if(!string) {
+                status = panic("failed to strcpy store object");
+            } else if(npc_walk(npc, string)) {
+                status = panic("failed to walk npc object - %s", string);
+            }
+        } else if(S_ISREG(info.st_mode)) {
+            if(npc_add(npc, name))
+                status = panic("failed to add npc object");
+        }
+    }
+
+    closedir(dir);
+
+    return status;
+}
+
+int npc_add(struct npc * npc, char * path) {
+    struct npc_file * file;
+
+    file = store_malloc(&npc->store, sizeof(*file));
+    if(!file)
+        return panic("failed to malloc store object");
+
+    file->path = store_strcpy(&npc->store, path, strlen(path));
+    if(!file->path)
+        return panic("failed to strcpy store object");
+
+    file->next = npc->root;
+    npc->root = file;
+    npc->count++;
+
+    return 0;
+}
+
+int npc_run(struct npc * npc, size_t jobs) {
+    int status = 0;
+
+    size_t i;
+    size_t count;
+    struct map_kv kv;
+    struct npc_worker * worker;
+
+    if(!jobs || jobs > NPC_JOB_MAX)
+        return panic("invalid jobs - %zu", jobs);
+
+    worker = calloc(jobs, sizeof(*worker));
+    if(!worker)
+        return panic("out of memory");
+
+    for(count = 0; count < jobs && !status; count++)
+        if(npc_worker_create(&worker[count], npc))
+            status = panic("failed to create npc worker object");
+
+    if(status)
+        count--;
+
+    for(i = 0; i < count; i++)
+        if(pthread_join(worker[i].thread, NULL))
+            status = panic("failed to join thread");
+
+    /* the workers' undefined lists are printed once */
+    for(i = 1; i < count && !status; i++) {
+        kv = map_start(&worker[i].script.undefined.map);
+        while(kv.key && !status) {
+            if(undefined_add(&worker[0].script.undefined, "%s", (char *) kv.key))
+                status = panic("failed to add undefined object");
+            kv = map_next(&worker[i].script.undefined.map);
+        }
+    }
+
+    if(count)
+        undefined_print(&worker[0].script.undefined);
+
+    if(!status && !atomic_load(&npc->status))
+        fprintf(stdout, "translated: %zu blocks in %zu files\nskipped: %zu files\n",
+            atomic_load(&npc->block), npc->count - atomic_load(&npc->skip), atomic_load(&npc->skip));
+
+    for(i = 0; i < count; i++)
+        npc_worker_destroy(&worker[i]);
+
+    free(worker);
+
+    if(atomic_load(&npc->status))
+        status = panic("failed to translate npc object");
+
+    return status;
+}
+
+int npc_worker_create(struct npc_worker * worker, struct npc * npc) {
+    int status = 0;
+
+    worker->npc = npc;
+
+    if(heap_create(&worker->heap, 4096)) {
+        status = panic("failed to create heap object");
+    } else if(script_create(&worker->script, 4096, &worker->heap, npc->table)) {
+        status = panic("failed to create script object");
+        goto script_fail;
+    } else if(strbuf_create(&worker->source, NPC_BLOCK_MAX)) {
+        status = panic("failed to create strbuf object");
+        goto source_fail;
+    } else if(strbuf_create(&worker->strbuf, NPC_BLOCK_MAX)) {
+        status = panic("failed to create strbuf object");
+        goto strbuf_fail;
+    } else if(strbuf_create(&worker->buffer, NPC_BLOCK_MAX * 2)) {
+        status = panic("failed to create strbuf object");
+        goto buffer_fail;
+    } else if(pthread_create(&worker->thread, NULL, npc_worker_run, worker)) {
+        status = panic("failed to create thread");
+        goto thread_fail;
+    }
+
+    return status;
+
+thread_fail:
+    strbuf_destroy(&worker->buffer);
+buffer_fail:
+    strbuf_destroy(&worker->strbuf);
+strbuf_fail:
+    strbuf_destroy(&worker->source);
+source_fail:
+    script_destroy(&worker->script);
+script_fail:
+    heap_destroy(&worker->heap);
+
+    return status;
+}
+
+void npc_worker_destroy(struct npc_worker * worker) {
+    strbuf_destroy(&worker->buffer);
+    strbuf_destroy(&worker->strbuf);
+    strbuf_destroy(&worker->source);
+    script_destroy(&worker->script);
+    heap_destroy(&worker->heap);
+}
+
+void * npc_worker_run(void * context) {
+    struct npc_worker * worker = context;
+    struct npc * npc = worker->npc;
+    size_t index;
+
+    while(!atomic_load_explicit(&npc->status, memory_order_relaxed)) {
+        index = atomic_fetch_add(&npc->next, 1);
+        if(index >= npc->count)
+            break;
+
+        if(npc_file(worker, npc->file[index]->path)) {
+            panic("failed to translate %s", npc->file[index]->path);
+            atomic_store(&npc->status, 1);
+        }
+    }
+
+    return NULL;
+}
+
+int npc_file(struct npc_worker * worker, char * path) {
+    int status = 0;
+
+    struct npc * npc = worker->npc;
+    char source[PATH_MAX];
+    char output[PATH_MAX];
+    struct stat info;
+    struct stat cache;
+    char * buffer;
+    size_t length;
+    uint64_t hash;
+
+    if(snprintf(source, sizeof(source), "%s/%s", npc->source, path) >= sizeof(source) ||
+       snprintf(output, sizeof(output), "%s/%s.yml", npc->output, path) >= sizeof(output))
+        return panic("invalid path - %s", path);
+
+    if(stat(source, &info))
+        return panic("failed to stat %s", source);
+
+    /* an output newer than the source is up to date */
+    if(!stat(output, &cache) && (cache.st_mtim.tv_sec > info.st_mtim.tv_sec ||
+       (cache.st_mtim.tv_sec == info.st_mtim.tv_sec && cache.st_mtim.tv_nsec > info.st_mtim.tv_nsec))) {
+        atomic_fetch_add(&npc->skip, 1);
+        return 0;
+    }
+
+    if(npc_read(source, &buffer, &length))
+        return panic("failed to read %s", source);
+
+    hash = npc_hash(buffer, length);
+
+    /* an output of the same content is touched instead of rewritten */
+    if(!npc_fresh(output, hash)) {
+        if(utimensat(AT_FDCWD, output, NULL, 0))
+            status = panic("failed to touch %s", output);
+        atomic_fetch_add(&npc->skip, 1);
+    } else if(npc_mkdir(output)) {
+        status = panic("failed to mkdir %s", output);
+    } else if(writer_open(&worker->writer, output, 0)) {
+        status = panic("failed to open writer object");
+    } else {
+        strbuf_clear(&worker->buffer);
+        if(strbuf_printf(&worker->buffer, "# %016llx\n", (unsigned long long) hash)) {
+            status = panic("failed to printf strbuf object");
+        } else if(writer_write(&worker->writer, worker->buffer.buf, worker->buffer.pos - worker->buffer.buf)) {
+            status = panic("failed to write writer object");
+        } else if(npc_translate(worker, buffer, length)) {
+            status = panic("failed to translate npc object");
+        }
+
+        if(writer_close(&worker->writer))
+            status = panic("failed to close writer object");
+
+        /* a partial output would be taken as up to date */
+        if(status)
+            unlink(output);
+    }
+
+    free(buffer);
+
+    return status;
+}
+
+int npc_read(char * path, char ** buffer, size_t * length) {
+    int status = 0;
+
+    int fd;
+    struct stat info;
+    ssize_t result;
+    size_t offset;
+
+    fd = open(path, O_RDONLY);
+    if(fd < 0) {
+        status = panic("failed to open %s", path);
+    } else {
+        if(fstat(fd, &info)) {
+            status = panic("failed to stat %s", path);
+        } else {
+            *buffer = malloc(info.st_size + 1);
+            if(!*buffer) {
+                status = panic("out of memory");
+            } else {
+                offset = 0;
+                while(offset < info.st_size && !status) {
+                    result = read(fd, *buffer + offset, info.st_size - offset);
+                    if(result < 0) {
+                        if(errno != EINTR)
+                            status = panic("failed to read %s", path);
+                    } else if(!result) {
+                        break;
+                    } else {
+                        offset += result;
+                    }
+                }
+
+                if(status) {
+                    free(*buffer);
+                } else {
+                    (*buffer)[offset] = 0;
+                    *length = offset;
+                }
+            }
+        }
+        close(fd);
+    }
+
+    return status;
+}
+
+int npc_fresh(char * path, uint64_t hash) {
+    int fd;
+    char line[32];
+    char * cursor;
+    ssize_t result;
+
+    fd = open(path, O_RDONLY);
+    if(fd < 0)
+        return 1;
+
+    result = read(fd, line, sizeof(line) - 1);
+    close(fd);
+
+    if(result < 3 || line[0] != '#')
+        return 1;
+
+    line[result] = 0;
+
+    return strtoull(line + 2, &cursor, 16) != hash || *cursor != '\n';
+}
+
+int npc_mkdir(char * path) {
+    char string[PATH_MAX];
+    char * cursor;
+
+    strcpy(string, path);
+
+    cursor = string;
+    while((cursor = strchr(cursor + 1, '/'))) {
+        *cursor = 0;
+        if(mkdir(string, 0755) && errno != EEXIST)
+            return panic("failed to mkdir %s", string);
+        *cursor = '/';
+    }
+
+    return 0;
+}
+
+int npc_translate(struct npc_worker * worker, char * string, size_t length) {
+    int curly = 0;
+    int quote = 0;
+    size_t line = 1;
+    size_t start = 0;
+    char * anchor = NULL;
+    char * header = string;
+    char * end = string + length;
+
+    while(string < end) {
+        if(quote) {
+            if(*string == '\\' && string + 1 < end) {
+                string++;
+            } else if(*string == '"') {
+                quote = 0;
+            } else if(*string == '\n') {
+                line++;
+            }
+        } else if(*string == '"') {
+            quote = 1;
+        } else if(*string == '/' && string + 1 < end && string[1] == '/') {
+            while(string + 1 < end && string[1] != '\n')
+                string++;
+        } else if(*string == '/' && string + 1 < end && string[1] == '*') {
+            string += 2;
+            while(string + 1 < end && !(string[0] == '*' && string[1] == '/')) {
+                if(*string == '\n')
+                    line++;
+                string++;
+            }
+        } else if(*string == '\n') {
+            line++;
+            if(!curly)
+                header = string + 1;
+        } else if(*string == '{') {
+            if(!curly) {
+                anchor = string;
+                start = line;
+            }
+            curly++;
+        } else if(*string == '}' && curly) {
+            curly--;
+            if(!curly) {
+                if(npc_block(worker, header, anchor, string - anchor + 1, start))
+                    return panic("failed to block npc object");
+                header = string + 1;
+            }
+        }
+        string++;
+    }
+
+    return 0;
+}
+
+int npc_block(struct npc_worker * worker, char * header, char * block, size_t length, size_t line) {
+    char * field;
+    char * cursor;
+    char * string;
+    size_t count;
+
+    strbuf_clear(&worker->source);
+    if(length >= NPC_BLOCK_MAX) {
+        panic("invalid block length - line %zu", line);
+        return 0;
+    } else if(strbuf_strcpy(&worker->source, block, length)) {
+        return panic("failed to strcpy strbuf object");
+    } else if(strbuf_putc(&worker->source, 0)) {
+        return panic("failed to putc strbuf object");
+    }
+
+    string = strbuf_array(&worker->source);
+    if(!string)
+        return panic("failed to array strbuf object");
+
+    /* parse failures are reported and the block is skipped */
+    if(script_compile(&worker->script, string, &worker->strbuf)) {
+        panic("failed to compile block - line %zu", line);
+        return 0;
+    }
+
+    string = strbuf_array(&worker->strbuf);
+    if(!string || !*string)
+        return 0;
+
+    strbuf_clear(&worker->buffer);
+    if(strbuf_printf(&worker->buffer, "- line: %zu\n", line))
+        return panic("failed to printf strbuf object");
+
+    /* the name is the third tab separated field of the header */
+    field = header;
+    for(count = 0; count < 2 && field < block; count++) {
+        while(field < block && *field != '\t')
+            field++;
+        if(field < block)
+            field++;
+    }
+
+    if(count == 2 && field < block) {
+        cursor = field;
+        while(cursor < block && *cursor != '\t')
+            cursor++;
+        if(cursor < block && cursor > field && strbuf_printf(&worker->buffer, "  name: %.*s\n", (int) (cursor - field), field))
+            return panic("failed to printf strbuf object");
+    }
+
+    if(strbuf_printf(&worker->buffer, "  script: |\n"))
+        return panic("failed to printf strbuf object");
+
+    while(*string) {
+        cursor = strchr(string, '\n');
+        if(!cursor)
+            cursor = string + strlen(string);
+        if(strbuf_printf(&worker->buffer, "    %.*s\n", (int) (cursor - string), string))
+            return panic("failed to printf strbuf object");
+        string = *cursor ? cursor + 1 : cursor;
+    }
+
+    if(writer_write(&worker->writer, worker->buffer.buf, worker->buffer.pos - worker->buffer.buf))
+        return panic("failed to write writer object");
+
+    atomic_fetch_add(&worker->npc->block, 1);
+
+    return 0;
+}
+
+uint64_t npc_hash(char * string, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;
+
+    while(length--) {
+        hash ^= (unsigned char) *string++;
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
@@ -0,0 +1,49 @@
+#ifndef npc_h
+#define npc_h
+
+#include <stdint.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "script.h"
+#include "writer.h"
+
+#define NPC_JOB_MAX 64
+#define NPC_BLOCK_MAX 1048576
+
+struct npc_file {
+    char * path;
+    struct npc_file * next;
+};
+
+struct npc {
+    struct table * table;
+    char * source;
+    char * output;
+    struct store store;
+    struct npc_file * root;
+    struct npc_file ** file;
+    size_t count;
+    atomic_size_t next;
+    atomic_size_t skip;
+    atomic_size_t block;
+    atomic_int status;
+};
+
+struct npc_worker {
+    struct npc * npc;
+    struct heap heap;
+    struct script script;
+    struct strbuf source;
+    struct strbuf strbuf;
+    struct strbuf buffer;
+    struct writer writer;
+    pthread_t thread;
+};
+
+int npc_create(struct npc *, size_t, struct table *, char *, char *);
+void npc_destroy(struct npc *);
+int npc_scan(struct npc *);
+int npc_run(struct npc *, size_t);
+
+#endif
@@ -1,9 +1,29 @@
 #include "panic.h"
 
+static _Thread_local int panic_mute;
+static _Thread_local char panic_first[256];
+
 int panic_(const char * format, ...) {
     va_list vararg;
     va_start(vararg, format);
-    vfprintf(stderr, format, vararg);
+    if(!panic_mute) {
+        vfprintf(stderr, format, vararg);
+    } else if(!*panic_first) {
+        vsnprintf(panic_first, sizeof(panic_first), format, vararg);
+    }
     va_end(vararg);
     return 1;
 }
+
+int panic_quiet(int quiet) {
+    int last = panic_mute;
+    panic_mute = quiet;
+    /* the first panic is kept across nested calls */
+    if(quiet && !last)
+        *panic_first = 0;
+    return last;
+}
+
+char * panic_reason(void) {
+    return panic_first;
+}
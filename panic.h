@@ -10,5 +10,7 @@
 
 #define panic(format, ...) panic_("%s (%s:%zu): " format ".\n", __FILE__, __func__, __LINE__, ## __VA_ARGS__)
 int panic_(const char *, ...);
+int panic_quiet(int);
+char * panic_reason(void);
 
 #endif
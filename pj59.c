@@ -1,9 +1,77 @@
 #include "unistd.h"
-#include "script.h"
+#include "getopt.h"
+#include "select.h"
+#include "emit.h"
+#include "npc.h"
+#include "check.h"
+#include "seek.h"
+#include "shape.h"
 
-int item_print(struct script *, struct item_node *, struct strbuf *);
-void bonus_print(char *);
-void combo_print(char *, char *);
+#define OPTION_MAX 64
+
+struct option_node {
+    int option;
+    char * string;
+};
+
+struct config {
+    char * path;
+    char * id;
+    char * output;
+    char * index;
+    int level;
+    int shape;
+    int check;
+    int render;
+    char * npc;
+    size_t jobs;
+    struct emit_backend * backend;
+    char * locale[LOCALE_MAX];
+    size_t locale_count;
+    struct option_node filter[OPTION_MAX];
+    size_t filter_count;
+};
+
+struct output {
+    size_t count;
+    struct config * config;
+    struct shape * shape;
+    struct writer writer[LOCALE_MAX];
+    struct ring ring[LOCALE_MAX];
+    struct emit emit[LOCALE_MAX];
+    struct sidecar sidecar[LOCALE_MAX];
+    struct strbuf strbuf[LOCALE_MAX];
+};
+
+struct option option_list[] = {
+    { "emitter", required_argument, NULL, 'e' },
+    { "output", required_argument, NULL, 'o' },
+    { "index", required_argument, NULL, 'x' },
+    { "compress", required_argument, NULL, 'c' },
+    { "shape", no_argument, NULL, 's' },
+    { "check", no_argument, NULL, 'k' },
+    { "generated", no_argument, NULL, 'g' },
+    { "npc", required_argument, NULL, 'N' },
+    { "jobs", required_argument, NULL, 'j' },
+    { "locale", required_argument, NULL, 'l' },
+    { "id", required_argument, NULL, 'i' },
+    { "file", required_argument, NULL, 'f' },
+    { "name", required_argument, NULL, 'n' },
+    { "reference", required_argument, NULL, 'r' },
+    { NULL, 0, NULL, 0 }
+};
+
+int config_parse(struct config *, int, char **);
+int output_create(struct output *, struct strbuf *, struct config *);
+int output_flush(struct output *, struct strbuf *);
+void output_destroy(struct output *);
+int table_parse(struct table *, struct strbuf *, struct config *, struct seek *);
+int locale_tag_path(struct table *, struct strbuf *, char *);
+int npc_print(struct table *, struct config *);
+int item_check(struct table *, struct heap *, struct config *);
+int option_select(struct select *, struct script *, struct option_node *, size_t);
+int item_print(struct script *, struct item_node *, struct output *);
+int item_compile(struct script *, char *, struct output *);
 
 int main(int argc, char ** argv) {
     int status = 0;
@@ -11,86 +79,115 @@ int main(int argc, char ** argv) {
     struct table table;
     struct script script;
     struct strbuf strbuf;
+    struct output output;
+    struct select select;
+    struct config config;
+    struct seek seek;
+    struct shape shape;
 
+    size_t i;
     struct item_node * item;
 
-    if(chdir(argv[1])) {
-        status = panic("failed to change directory");
+    seek.table = NULL;
+
+    if(config_parse(&config, argc, argv)) {
+        status = panic("usage: %s [-e yaml|ndjson] [-o output] [-x index] [-c level] [-s] [-g] [-k [-j jobs]] [-N npc -o output [-j jobs]] [-l locale] [-i id[-id]] [-f file] [-n name] [-r identifier] path [id]", argv[0]);
     } else if(heap_create(&heap, 4096)) {
         status = panic("failed to create heap object");
     } else {
         if(table_create(&table, 4096, &heap)) {
             status = panic("failed to create table object");
         } else {
-            if(table_item_parse(&table, "item_db.txt")) {
-                status = panic("failed to item parse table object");
-            } else if(table_item_combo_parse(&table, "item_combo_db.txt")) {
-                status = panic("failed to item combo parse table object");
-            } else if(table_skill_parse(&table, "skill_db.yml")) {
-                status = panic("failed to skill parse table object");
-            } else if(table_mob_parse(&table, "mob_db.txt")) {
-                status = panic("failed to mob parse table object");
-            } else if(table_mercenary_parse(&table, "mercenary_db.txt")) {
-                status = panic("failed to mercenary parse table object");
-            } else if(table_constant_parse(&table, "constant.yml")) {
-                status = panic("failed to constant parse table object");
-            } else if(table_constant_data_parse(&table, "constant_data.yml")) {
-                status = panic("failed to constant data parse table object");
-            } else if(table_constant_group_parse(&table, "constant_group.yml")) {
-                status = panic("failed to constant group parse table object");
-            } else if(table_argument_parse(&table, "argument.yml")) {
-                status = panic("failed to argument parse table object");
-            } else if(table_bonus_parse(&table, "bonus.yml")) {
-                status = panic("failed to bonus parse table object");
-            } else if(table_bonus2_parse(&table, "bonus2.yml")) {
-                status = panic("failed to bonus2 parse table object");
-            } else if(table_bonus3_parse(&table, "bonus3.yml")) {
-                status = panic("failed to bonus3 parse table object");
-            } else if(table_bonus4_parse(&table, "bonus4.yml")) {
-                status = panic("failed to bonus4 parse table object");
-            } else if(table_bonus5_parse(&table, "bonus5.yml")) {
-                status = panic("failed to bonus5 parse table object");
-            } else if(table_sc_start_parse(&table, "sc_start.yml")) {
-                status = panic("failed to sc_start parse table object");
-            } else if(table_sc_start2_parse(&table, "sc_start2.yml")) {
-                status = panic("failed to sc_start2 parse table object");
-            } else if(table_sc_start4_parse(&table, "sc_start4.yml")) {
-                status = panic("failed to sc_start4 parse table object");
-            } else if(table_statement_parse(&table, "statement.yml")) {
-                status = panic("failed to statement parse table object");
+            if(strbuf_create(&strbuf, 4096)) {
+                status = panic("failed to create strbuf object");
             } else {
-                if(script_setup(&table)) {
+                if(table_parse(&table, &strbuf, &config, &seek)) {
+                    status = panic("failed to parse table object");
+                } else if(table_locale_parse(&table, &strbuf, config.path)) {
+                    status = panic("failed to locale parse table object");
+                } else {
+                    for(i = 0; i < config.locale_count && !status; i++) {
+                        if(table_locale_create(&table, 4096, &heap)) {
+                            status = panic("failed to locale create table object");
+                        } else if(table_locale_parse(&table, &strbuf, config.locale[i])) {
+                            status = panic("failed to locale parse table object - %s", config.locale[i]);
+                        } else if(locale_tag_path(&table, &strbuf, config.locale[i])) {
+                            status = panic("failed to locale tag parse table object - %s", config.locale[i]);
+                        }
+                    }
+                }
+
+                if(status) {
+                    /* skip */
+                } else if(script_setup(&table, &heap, config.render ? render_list : NULL)) {
                     status = panic("failed to setup script object");
+                } else if(config.npc) {
+                    if(npc_print(&table, &config))
+                        status = panic("failed to print npc object");
+                } else if(config.check) {
+                    if(item_check(&table, &heap, &config))
+                        status = panic("failed to check item");
                 } else if(script_create(&script, 4096, &heap, &table)) {
                     status = panic("failed to create script object");
                 } else {
-                    if(strbuf_create(&strbuf, 4096)) {
-                        status = panic("failed to create strbuf object");
+                    if(output_create(&output, &strbuf, &config)) {
+                        status = panic("failed to create output object");
+                    } else if(config.shape && shape_create(&shape, 65536, &heap, &script)) {
+                        status = panic("failed to create shape object");
+                        output_destroy(&output);
                     } else {
-                        if(argc < 3) {
+                        if(config.shape)
+                            output.shape = &shape;
+                        if(config.filter_count) {
+                            if(select_create(&select, 4096, &heap, &table)) {
+                                status = panic("failed to create select object");
+                            } else {
+                                if(option_select(&select, &script, config.filter, config.filter_count)) {
+                                    status = panic("failed to select item");
+                                } else {
+                                    item = select_start(&select);
+                                    while(item && !status) {
+                                        if(item_print(&script, item, &output)) {
+                                            status = panic("failed to print item - %ld", item->id);
+                                        } else {
+                                            item = select_next(&select);
+                                        }
+                                    }
+                                }
+                                select_destroy(&select);
+                            }
+                        } else if(!config.id) {
                             item = item_start(&table);
                             while(item && !status) {
-                                if(item_print(&script, item, &strbuf)) {
+                                if(item_print(&script, item, &output)) {
                                     status = panic("failed to print item - %ld", item->id);
                                 } else {
                                     item = item_next(&table);
                                 }
                             }
                         } else {
-                            item = item_id(&table, strtol(argv[2], NULL, 0));
+                            item = item_id(&table, strtol(config.id, NULL, 0));
                             if(!item) {
-                                status = panic("invalid item id - %s", argv[2]);
-                            } else if(item_print(&script, item, &strbuf)) {
+                                status = panic("invalid item id - %s", config.id);
+                            } else if(item_print(&script, item, &output)) {
                                 status = panic("failed to print item - %ld", item->id);
                             }
                         }
 
+                        if(output_flush(&output, &strbuf))
+                            status = panic("failed to flush output object");
+
                         undefined_print(&script.undefined);
 
-                        strbuf_destroy(&strbuf);
+                        if(config.shape)
+                            shape_destroy(&shape);
+                        output_destroy(&output);
                     }
                     script_destroy(&script);
                 }
+                if(seek.table)
+                    seek_destroy(&seek);
+                strbuf_destroy(&strbuf);
             }
             table_destroy(&table);
         }
@@ -100,85 +197,383 @@ int main(int argc, char ** argv) {
     return status;
 }
 
-int item_print(struct script * script, struct item_node * item, struct strbuf * strbuf) {
-    struct item_combo_node * combo;
+int config_parse(struct config * config, int argc, char ** argv) {
+    int option;
 
-    fprintf(
-        stdout,
-        "- id: %ld\n"
-        "  name: %s\n",
-        item->id,
-        item->name
-    );
+    config->path = NULL;
+    config->id = NULL;
+    config->output = NULL;
+    config->index = NULL;
+    config->level = 0;
+    config->shape = 0;
+    config->check = 0;
+    config->render = 0;
+    config->npc = NULL;
+    config->jobs = 1;
+    config->backend = emit_backend("yaml");
+    config->locale_count = 0;
+    config->filter_count = 0;
 
-    if(script_compile(script, item->bonus, strbuf)) {
-        return panic("failed to compile script object");
-    } else {
-        bonus_print(strbuf_array(strbuf));
+    while((option = getopt_long(argc, argv, "e:o:x:c:skgN:j:l:i:f:n:r:", option_list, NULL)) != -1) {
+        switch(option) {
+            case 'e':
+                config->backend = emit_backend(optarg);
+                if(!config->backend)
+                    return panic("invalid emitter - %s", optarg);
+                break;
+            case 'o':
+                config->output = optarg;
+                break;
+            case 'x':
+                config->index = optarg;
+                break;
+            case 'c':
+                config->level = strtol(optarg, NULL, 0);
+                if(config->level < 1)
+                    return panic("invalid level - %s", optarg);
+                break;
+            case 's':
+                config->shape = 1;
+                break;
+            case 'k':
+                config->check = 1;
+                break;
+            case 'g':
+                config->render = 1;
+                break;
+            case 'N':
+                config->npc = optarg;
+                break;
+            case 'j':
+                config->jobs = strtoul(optarg, NULL, 0);
+                if(!config->jobs || config->jobs > NPC_JOB_MAX)
+                    return panic("invalid jobs - %s", optarg);
+                break;
+            case 'l':
+                if(config->locale_count >= LOCALE_MAX - 1)
+                    return panic("out of locale - %s", optarg);
+                config->locale[config->locale_count++] = optarg;
+                break;
+            case 'i':
+            case 'f':
+            case 'n':
+            case 'r':
+                if(config->filter_count >= OPTION_MAX)
+                    return panic("out of option - %s", optarg);
+                config->filter[config->filter_count].option = option;
+                config->filter[config->filter_count].string = optarg;
+                config->filter_count++;
+                break;
+            default:
+                return 1;
+        }
+    }
 
-        if(item->combo) {
-            fprintf(stdout, "  combo:\n");
+    if(optind >= argc)
+        return panic("missing path");
 
-            combo = item->combo;
-            while(combo) {
-                if(script_compile(script, combo->bonus, strbuf)) {
-                    return panic("failed to compile script object");
-                } else {
-                    combo_print(combo->combo, strbuf_array(strbuf));
-                }
-                combo = combo->next;
+    if(config->npc && !config->output)
+        return panic("missing output directory");
+
+    config->path = argv[optind];
+    if(optind + 1 < argc)
+        config->id = argv[optind + 1];
+
+    return 0;
+}
+
+int output_create(struct output * output, struct strbuf * strbuf, struct config * config) {
+    int status = 0;
+
+    char * path;
+
+    output->count = 0;
+    output->config = config;
+    output->shape = NULL;
+
+    while(output->count <= config->locale_count && !status) {
+        path = NULL;
+        if(!output->count) {
+            path = config->output;
+        } else {
+            strbuf_clear(strbuf);
+            if(strbuf_printf(strbuf, "%s/output.%s%s", config->locale[output->count - 1], config->backend->extension, config->level ? WRITER_EXTENSION : "")) {
+                status = panic("failed to printf strbuf object");
+            } else if(!(path = strbuf_array(strbuf))) {
+                status = panic("failed to array strbuf object");
             }
         }
+
+        if(status) {
+            /* skip */
+        } else if(writer_open(&output->writer[output->count], path, config->level)) {
+            status = panic("failed to open writer object");
+        } else if(ring_create(&output->ring[output->count], 4, 1048576, &output->writer[output->count])) {
+            status = panic("failed to create ring object");
+            goto ring_fail;
+        } else if(emit_create(&output->emit[output->count], &output->ring[output->count], config->backend)) {
+            status = panic("failed to create emit object");
+            goto emit_fail;
+        } else if(strbuf_create(&output->strbuf[output->count], 4096)) {
+            status = panic("failed to create strbuf object");
+            goto strbuf_fail;
+        } else if(config->index && sidecar_create(&output->sidecar[output->count], 4096)) {
+            status = panic("failed to create sidecar object");
+            goto sidecar_fail;
+        } else {
+            if(config->index)
+                output->emit[output->count].sidecar = &output->sidecar[output->count];
+            output->count++;
+        }
+    }
+
+    if(status)
+        output_destroy(output);
+
+    return status;
+
+sidecar_fail:
+    strbuf_destroy(&output->strbuf[output->count]);
+strbuf_fail:
+    emit_destroy(&output->emit[output->count]);
+emit_fail:
+    ring_destroy(&output->ring[output->count]);
+ring_fail:
+    writer_close(&output->writer[output->count]);
+    output_destroy(output);
+
+    return status;
+}
+
+int output_flush(struct output * output, struct strbuf * strbuf) {
+    size_t i;
+    char * path;
+    struct config * config;
+
+    config = output->config;
+
+    for(i = 0; i < output->count; i++) {
+        if(emit_flush(&output->emit[i])) {
+            return panic("failed to flush emit object");
+        } else if(ring_close(&output->ring[i])) {
+            return panic("failed to close ring object");
+        } else if(writer_close(&output->writer[i])) {
+            return panic("failed to close writer object");
+        }
+
+        if(config->index) {
+            if(!i) {
+                path = config->index;
+            } else {
+                strbuf_clear(strbuf);
+                if(strbuf_printf(strbuf, "%s/output.%s.idx", config->locale[i - 1], config->backend->extension))
+                    return panic("failed to printf strbuf object");
+                path = strbuf_array(strbuf);
+                if(!path)
+                    return panic("failed to array strbuf object");
+            }
+
+            if(sidecar_write(&output->sidecar[i], path))
+                return panic("failed to write sidecar object - %s", path);
+        }
     }
 
     return 0;
 }
 
-void bonus_print(char * bonus) {
-    char * anchor;
-    char * cursor;
-
-    if(bonus && *bonus) {
-        fprintf(stdout, "  bonus: |\n");
-
-        anchor = bonus;
-        cursor = strchr(anchor, '\n');
-        while(cursor) {
-            fputs("    ", stdout);
-            fwrite(anchor, 1, cursor - anchor, stdout);
-            fputc('\n', stdout);
-            anchor = cursor + 1;
-            cursor = strchr(anchor, '\n');
+void output_destroy(struct output * output) {
+    while(output->count > 0) {
+        output->count--;
+        if(output->config->index)
+            sidecar_destroy(&output->sidecar[output->count]);
+        strbuf_destroy(&output->strbuf[output->count]);
+        emit_destroy(&output->emit[output->count]);
+        ring_destroy(&output->ring[output->count]);
+        writer_close(&output->writer[output->count]);
+    }
+}
+
+int table_parse(struct table * table, struct strbuf * strbuf, struct config * config, struct seek * seek) {
+    int status = 0;
+
+    static char * file[] = {
+        "item_db.txt",
+        "item_combo_db.txt",
+        "skill_db.yml",
+        "mob_db.txt",
+        "mercenary_db.txt",
+        "constant.yml",
+        "constant_data.yml",
+        "constant_group.yml",
+        "function.txt",
+        NULL
+    };
+
+    static table_parse_cb parse[] = {
+        table_item_parse,
+        table_item_combo_parse,
+        table_skill_defer,
+        table_mob_defer,
+        table_mercenary_defer,
+        table_constant_parse,
+        table_constant_data_parse,
+        table_constant_group_parse,
+        table_callfunc_parse
+    };
+
+    size_t i = 0;
+    char * string;
+    char * path = config->path;
+
+    /* a single item is read from its rows when item_db.txt is indexed */
+    if(config->id && !config->filter_count && !config->npc && !seek_create(seek, table, strbuf, path)) {
+        if(seek_item(seek, strtol(config->id, NULL, 0)))
+            return panic("failed to seek item - %s", config->id);
+        i = 2;
+    }
+
+    for(; file[i] && !status; i++) {
+        strbuf_clear(strbuf);
+        if(strbuf_printf(strbuf, "%s/%s", path, file[i])) {
+            status = panic("failed to printf strbuf object");
+        } else if(!(string = strbuf_array(strbuf))) {
+            status = panic("failed to array strbuf object");
+        } else if(parse[i](table, string)) {
+            status = panic("failed to parse table object - %s", string);
         }
-        fputs("    ", stdout);
-        fputs(anchor, stdout);
-        fputc('\n', stdout);
     }
+
+    return status;
 }
 
-void combo_print(char * combo, char * bonus) {
-    char * anchor;
-    char * cursor;
-
-    fprintf(
-        stdout,
-        "    - |\n"
-        "      [%s]\n",
-        combo
-    );
-
-    if(bonus && *bonus) {
-        anchor = bonus;
-        cursor = strchr(anchor, '\n');
-        while(cursor) {
-            fputs("      ", stdout);
-            fwrite(anchor, 1, cursor - anchor, stdout);
-            fputc('\n', stdout);
-            anchor = cursor + 1;
-            cursor = strchr(anchor, '\n');
+int locale_tag_path(struct table * table, struct strbuf * strbuf, char * path) {
+    int status = 0;
+
+    char * string;
+
+    strbuf_clear(strbuf);
+    if(strbuf_printf(strbuf, "%s/constant_data.yml", path)) {
+        status = panic("failed to printf strbuf object");
+    } else if(!(string = strbuf_array(strbuf))) {
+        status = panic("failed to array strbuf object");
+    } else if(access(string, R_OK)) {
+        /* use the default constant tag */
+    } else if(table_constant_tag_parse(table, string)) {
+        status = panic("failed to constant tag parse table object - %s", string);
+    }
+
+    return status;
+}
+
+int npc_print(struct table * table, struct config * config) {
+    int status = 0;
+
+    struct npc npc;
+
+    if(table->count && table_locale_set(table, 0)) {
+        status = panic("failed to locale set table object");
+    } else if(npc_create(&npc, 4096, table, config->npc, config->output)) {
+        status = panic("failed to create npc object");
+    } else {
+        if(npc_scan(&npc)) {
+            status = panic("failed to scan npc object");
+        } else if(npc_run(&npc, config->jobs)) {
+            status = panic("failed to run npc object");
+        }
+        npc_destroy(&npc);
+    }
+
+    return status;
+}
+
+int item_check(struct table * table, struct heap * heap, struct config * config) {
+    int status = 0;
+
+    struct check check;
+
+    if(table->count && table_locale_set(table, 0)) {
+        status = panic("failed to locale set table object");
+    } else if(check_create(&check, 4096, heap, table)) {
+        status = panic("failed to create check object");
+    } else {
+        if(check_run(&check, config->jobs)) {
+            status = panic("failed to run check object");
+        } else if(check.fail) {
+            status = panic("failed to translate %zu of %zu items", check.fail, check.item_count);
         }
-        fputs("      ", stdout);
-        fputs(anchor, stdout);
-        fputc('\n', stdout);
+        check_destroy(&check);
     }
+
+    return status;
+}
+
+int option_select(struct select * select, struct script * script, struct option_node * option, size_t count) {
+    int status = 0;
+
+    size_t i;
+
+    for(i = 0; i < count && !status; i++) {
+        switch(option[i].option) {
+            case 'i':
+                if(select_id(select, option[i].string))
+                    status = panic("failed to id select object - %s", option[i].string);
+                break;
+            case 'f':
+                if(select_file(select, option[i].string))
+                    status = panic("failed to file select object - %s", option[i].string);
+                break;
+            case 'n':
+                if(select_name(select, script, option[i].string))
+                    status = panic("failed to name select object - %s", option[i].string);
+                break;
+            case 'r':
+                if(select_reference(select, script, option[i].string))
+                    status = panic("failed to reference select object - %s", option[i].string);
+                break;
+        }
+    }
+
+    return status;
+}
+
+int item_print(struct script * script, struct item_node * item, struct output * output) {
+    size_t i;
+    struct item_combo_node * combo;
+
+    for(i = 0; i < output->count; i++)
+        if(emit_item(&output->emit[i], item))
+            return panic("failed to item emit object");
+
+    if(item_compile(script, item->bonus, output)) {
+        return panic("failed to compile script object");
+    } else {
+        for(i = 0; i < output->count; i++)
+            if(emit_bonus(&output->emit[i], strbuf_array(&output->strbuf[i])))
+                return panic("failed to bonus emit object");
+
+        combo = item->combo;
+        while(combo) {
+            if(item_compile(script, combo->bonus, output)) {
+                return panic("failed to compile script object");
+            } else {
+                for(i = 0; i < output->count; i++)
+                    if(emit_combo(&output->emit[i], combo->combo, strbuf_array(&output->strbuf[i])))
+                        return panic("failed to combo emit object");
+            }
+            combo = combo->next;
+        }
+    }
+
+    for(i = 0; i < output->count; i++)
+        if(emit_end(&output->emit[i]))
+            return panic("failed to end emit object");
+
+    return 0;
+}
+
+int item_compile(struct script * script, char * string, struct output * output) {
+    if(output->shape)
+        return shape_compile(output->shape, string, output->strbuf, output->count);
+
+    return script_compile_locale(script, string, output->strbuf, output->count);
 }
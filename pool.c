@@ -11,6 +11,17 @@ int pool_create(struct pool * pool, size_t size, size_t count) {
     pool->count = count;
     pool->root = NULL;
     pool->cache = NULL;
+    pool->zone = NULL;
+
+    return 0;
+}
+
+int pool_create_zone(struct pool * pool, size_t size, struct zone * zone) {
+    if(pool_create(pool, size, 1))
+        return panic("failed to create pool object");
+
+    /* the objects are taken from the zone and released with it */
+    pool->zone = zone;
 
     return 0;
 }
@@ -27,11 +38,23 @@ void pool_destroy(struct pool * pool) {
     pool->root = NULL;
 }
 
+void pool_clear(struct pool * pool) {
+    /* drop the free objects of a zone pool before the zone is cleared */
+    pool->root = NULL;
+}
+
 void * pool_add(struct pool * pool) {
     size_t i;
     char * buffer;
     struct pool_node * node;
 
+    if(pool->zone) {
+        buffer = zone_get(pool->zone, pool->size);
+        if(buffer)
+            pool_put(pool, buffer);
+        return pool->root;
+    }
+
     node = malloc(sizeof(*node) + pool->size * pool->count);
     if(node) {
         node->next = pool->cache;
@@ -3,6 +3,8 @@
 
 #include "panic.h"
 
+struct zone;
+
 struct pool_node {
     struct pool_node * next;
 };
@@ -12,10 +14,13 @@ struct pool {
     size_t count;
     struct pool_node * root;
     struct pool_node * cache;
+    struct zone * zone;
 };
 
 int pool_create(struct pool *, size_t, size_t);
+int pool_create_zone(struct pool *, size_t, struct zone *);
 void pool_destroy(struct pool *);
+void pool_clear(struct pool *);
 void * pool_get(struct pool *);
 void pool_put(struct pool *, void *);
 
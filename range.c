@@ -566,3 +566,66 @@ int range_pow(struct range * range, struct range * x, struct range * y) {
 
     return status;
 }
+
+int range_overlap(struct range * x, struct range * y) {
+    struct range_node * l;
+    struct range_node * r;
+
+    l = x->root;
+    r = y->root;
+    while(l && r) {
+        if(l->min > r->max) {
+            r = r->next;
+        } else if(l->max < r->min) {
+            l = l->next;
+        } else {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int range_same(struct range * x, struct range * y) {
+    struct range_node * l;
+    struct range_node * r;
+
+    l = x->root;
+    r = y->root;
+    while(l && r && l->min == r->min && l->max == r->max) {
+        l = l->next;
+        r = r->next;
+    }
+
+    return !l && !r;
+}
+
+int range_member(struct range * range, long value) {
+    struct range_node * iter;
+
+    iter = range->root;
+    while(iter && iter->max < value)
+        iter = iter->next;
+
+    return iter && iter->min <= value;
+}
+
+void range_truth(struct range * range, long * min, long * max) {
+    struct range_node * iter;
+
+    *min = 0;
+    *max = 1;
+
+    /* an empty range is an unknown value */
+    if(range->root) {
+        iter = range->root;
+        while(iter && iter->max < 0)
+            iter = iter->next;
+
+        if(!iter || iter->min > 0) {
+            *min = 1;
+        } else if(range->min == 0 && range->max == 0) {
+            *max = 0;
+        }
+    }
+}
@@ -53,4 +53,8 @@ int range_decrement(struct range *, struct range *);
 int range_min(struct range *, struct range *, struct range *);
 int range_max(struct range *, struct range *, struct range *);
 int range_pow(struct range *, struct range *, struct range *);
+int range_overlap(struct range *, struct range *);
+int range_same(struct range *, struct range *);
+int range_member(struct range *, long);
+void range_truth(struct range *, long *, long *);
 #endif
@@ -0,0 +1,401 @@
+#include "script.h"
+
+#define RENDER_HANDLER_MAX 32
+
+struct render {
+    FILE * file;
+    size_t count;
+    char * handler[RENDER_HANDLER_MAX];
+    size_t handler_count;
+};
+
+int render_parse(struct table *, struct heap *, char *);
+int render_write(struct render *, struct locale *);
+int render_handler(struct render *, struct argument_node *);
+int render_check(struct argument_node *);
+int render_check_entry(struct entry_node *);
+int render_inline(struct entry_node *);
+void render_argument(struct render *, struct argument_node *);
+void render_print(struct render *, struct print_node *, size_t);
+void render_string(FILE *, char *, size_t);
+void render_flag(FILE *, struct integer_node *);
+
+static char * render_name[] = {
+    "argument",
+    "bonus",
+    "bonus2",
+    "bonus3",
+    "bonus4",
+    "bonus5",
+    "sc_start",
+    "sc_start2",
+    "sc_start4",
+    "statement",
+    NULL
+};
+
+int main(int argc, char ** argv) {
+    int status = 0;
+    struct heap heap;
+    struct table table;
+    struct render render;
+
+    if(argc < 3) {
+        status = panic("usage: %s path output", argv[0]);
+    } else if(heap_create(&heap, 4096)) {
+        status = panic("failed to create heap object");
+    } else {
+        if(table_create(&table, 4096, &heap)) {
+            status = panic("failed to create table object");
+        } else {
+            if(render_parse(&table, &heap, argv[1])) {
+                status = panic("failed to parse table object - %s", argv[1]);
+            } else {
+                render.file = fopen(argv[2], "w");
+                if(!render.file) {
+                    status = panic("failed to open %s", argv[2]);
+                } else {
+                    render.count = 0;
+                    render.handler_count = 0;
+                    if(render_write(&render, &table.locale[0]))
+                        status = panic("failed to write render object");
+                    if(fclose(render.file))
+                        status = panic("failed to close %s", argv[2]);
+                    if(status)
+                        remove(argv[2]);
+                }
+            }
+            table_destroy(&table);
+        }
+        heap_destroy(&heap);
+    }
+
+    return status;
+}
+
+int render_parse(struct table * table, struct heap * heap, char * path) {
+    int status = 0;
+
+    char * string;
+    struct strbuf strbuf;
+
+    if(strbuf_create(&strbuf, 4096)) {
+        status = panic("failed to create strbuf object");
+    } else {
+        if(strbuf_printf(&strbuf, "%s/constant.yml", path)) {
+            status = panic("failed to printf strbuf object");
+        } else if(!(string = strbuf_array(&strbuf))) {
+            status = panic("failed to array strbuf object");
+        } else if(table_constant_parse(table, string)) {
+            status = panic("failed to parse table object - %s", string);
+        } else if(table_locale_parse(table, &strbuf, path)) {
+            status = panic("failed to locale parse table object");
+        } else if(script_setup(table, heap, NULL)) {
+            status = panic("failed to setup script object");
+        }
+        strbuf_destroy(&strbuf);
+    }
+
+    return status;
+}
+
+int render_write(struct render * render, struct locale * locale) {
+    size_t i;
+    size_t j;
+    struct argument * argument[] = {
+        &locale->argument,
+        &locale->bonus,
+        &locale->bonus2,
+        &locale->bonus3,
+        &locale->bonus4,
+        &locale->bonus5,
+        &locale->sc_start,
+        &locale->sc_start2,
+        &locale->sc_start4,
+        &locale->statement
+    };
+    struct argument_node * node;
+
+    fprintf(render->file, "/* generated by render from the templates; do not edit */\n\n#include \"script.h\"\n\n");
+
+    /* the handlers called by name need a prototype */
+    for(i = 0; render_name[i]; i++) {
+        node = argument[i]->argument;
+        while(node) {
+            if(render_check(node) && render_handler(render, node))
+                return panic("failed to handler render object");
+            node = node->next;
+        }
+    }
+
+    for(j = 0; j < render->handler_count; j++)
+        fprintf(render->file, "int argument_%s(struct script *, struct stack *, struct argument_node *, struct strbuf *);\n", render->handler[j]);
+
+    for(i = 0; render_name[i]; i++) {
+        node = argument[i]->argument;
+        while(node) {
+            if(render_check(node))
+                render_argument(render, node);
+            node = node->next;
+        }
+    }
+
+    fprintf(render->file, "\nstruct render_entry render_list[] = {\n");
+    render->count = 0;
+    for(i = 0; render_name[i]; i++) {
+        node = argument[i]->argument;
+        while(node) {
+            if(render_check(node)) {
+                fprintf(render->file, "    { \"%s\", ", render_name[i]);
+                render_string(render->file, node->identifier, strlen(node->identifier));
+                fprintf(render->file, ", %luUL, render_%zu },\n", argument_digest(node), render->count++);
+            }
+            node = node->next;
+        }
+    }
+    fprintf(render->file, "    { NULL, NULL, 0, NULL }\n};\n");
+
+    return ferror(render->file) ? panic("failed to write file object") : 0;
+}
+
+int render_handler(struct render * render, struct argument_node * argument) {
+    size_t i;
+    struct print_node * print;
+    struct entry_node * entry;
+
+    print = argument->print;
+    while(print) {
+        entry = print->entry;
+        while(entry) {
+            if(entry->identifier && entry->callback) {
+                for(i = 0; i < render->handler_count; i++)
+                    if(!strcmp(render->handler[i], entry->identifier))
+                        break;
+
+                if(i == render->handler_count) {
+                    if(render->handler_count >= RENDER_HANDLER_MAX)
+                        return panic("out of handler - %s", entry->identifier);
+                    render->handler[render->handler_count++] = entry->identifier;
+                }
+            }
+            entry = entry->next;
+        }
+        print = print->next;
+    }
+
+    return 0;
+}
+
+int render_check(struct argument_node * argument) {
+    struct print_node * print;
+
+    /* the other handlers are bound directly and are not generated */
+    if(!argument->handler || !strcmp(argument->handler, "print")) {
+        print = argument->print;
+    } else if(!strcmp(argument->handler, "prefix")) {
+        if(!argument->print || !argument->print->next)
+            return 0;
+        print = argument->print;
+    } else if(!strcmp(argument->handler, "zero")) {
+        if(!argument->print)
+            return 0;
+        print = argument->print;
+    } else if(!strcmp(argument->handler, "integer")) {
+        return 1;
+    } else {
+        return 0;
+    }
+
+    while(print) {
+        if(!render_check_entry(print->entry))
+            return 0;
+        print = print->next;
+    }
+
+    return 1;
+}
+
+int render_check_entry(struct entry_node * entry) {
+    /* an undefined argument is left to fail in the interpreter */
+    while(entry) {
+        if(entry->identifier && !entry->callback && !entry->argument)
+            return 0;
+        entry = entry->next;
+    }
+
+    return 1;
+}
+
+int render_inline(struct entry_node * entry) {
+    return entry->argument->handler && !strcmp(entry->argument->handler, "integer") && !entry->argument->optional;
+}
+
+void render_argument(struct render * render, struct argument_node * argument) {
+    size_t i;
+    size_t count;
+    FILE * file = render->file;
+    struct print_node * print;
+
+    count = 0;
+    print = argument->print;
+    while(print) {
+        count++;
+        print = print->next;
+    }
+
+    if(argument->handler && !strcmp(argument->handler, "prefix")) {
+        count = 2;
+    } else if(argument->handler && !strcmp(argument->handler, "zero")) {
+        count = 1;
+    } else if(argument->handler && !strcmp(argument->handler, "integer")) {
+        count = 0;
+    }
+
+    fprintf(file, "\n/* %s */\n", argument->identifier);
+
+    print = argument->print;
+    for(i = 0; i < count; i++) {
+        render_print(render, print, i);
+        print = print->next;
+    }
+
+    fprintf(file, "static int render_%zu(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {\n", render->count);
+
+    if(argument->handler && !strcmp(argument->handler, "integer")) {
+        fprintf(file, "    struct script_range * range;\n\n");
+        fprintf(file, "    range = stack_get(stack, 0);\n");
+        fprintf(file, "    if(!range) {\n");
+        fprintf(file, "        return panic(\"failed to get stack object\");\n");
+        fprintf(file, "    } else if(argument_integer_write(strbuf, range, ");
+        render_flag(file, argument->integer);
+        fprintf(file, ")) {\n");
+        fprintf(file, "        return panic(\"failed to write integer argument object\");\n");
+        fprintf(file, "    }\n");
+    } else if(argument->handler && !strcmp(argument->handler, "prefix")) {
+        fprintf(file, "    struct script_range * range;\n\n");
+        fprintf(file, "    range = stack_get(stack, 0);\n");
+        fprintf(file, "    if(!range) {\n");
+        fprintf(file, "        return panic(\"failed to get stack object\");\n");
+        fprintf(file, "    } else if(range->range->max < 0) {\n");
+        fprintf(file, "        if(render_%zu_1(script, stack, argument, strbuf))\n", render->count);
+        fprintf(file, "            return panic(\"failed to write argument object\");\n");
+        fprintf(file, "    } else if(render_%zu_0(script, stack, argument, strbuf)) {\n", render->count);
+        fprintf(file, "        return panic(\"failed to write argument object\");\n");
+        fprintf(file, "    }\n");
+    } else if(argument->handler && !strcmp(argument->handler, "zero")) {
+        fprintf(file, "    struct script_range * range;\n\n");
+        fprintf(file, "    range = stack_get(stack, 0);\n");
+        fprintf(file, "    if(!range) {\n");
+        fprintf(file, "        return panic(\"failed to get stack object\");\n");
+        fprintf(file, "    } else if(range->range->min || range->range->max) {\n");
+        fprintf(file, "        if(render_%zu_0(script, stack, argument, strbuf))\n", render->count);
+        fprintf(file, "            return panic(\"failed to write argument object\");\n");
+        fprintf(file, "    }\n");
+    } else {
+        /* each line is separated from the last if the last wrote anything */
+        if(count > 1)
+            fprintf(file, "    char * anchor;\n\n    anchor = strbuf->pos;\n");
+        for(i = 0; i < count; i++) {
+            if(i) {
+                fprintf(file, "    if(anchor != strbuf->pos && strbuf_putc(strbuf, '\\n'))\n");
+                fprintf(file, "        return panic(\"failed to putc strbuf object\");\n");
+                fprintf(file, "    anchor = strbuf->pos;\n");
+            }
+            fprintf(file, "    if(render_%zu_%zu(script, stack, argument, strbuf))\n", render->count, i);
+            fprintf(file, "        return panic(\"failed to parse argument object\");\n");
+        }
+        fprintf(file, "    strbuf_trim(strbuf);\n");
+    }
+
+    fprintf(file, "\n    return 0;\n}\n");
+
+    render->count++;
+}
+
+void render_print(struct render * render, struct print_node * print, size_t index) {
+    size_t i;
+    size_t j;
+    char * branch = "if";
+    FILE * file = render->file;
+    struct entry_node * entry;
+
+    fprintf(file, "static int render_%zu_%zu(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {\n", render->count, index);
+    fprintf(file, "    int status = 0;\n");
+    fprintf(file, "    struct stack subset;\n\n");
+    fprintf(file, "    if(stack_create(&subset, script->heap->stack_pool))\n");
+    fprintf(file, "        return panic(\"failed to create stack object\");\n\n");
+
+    entry = print->entry;
+    for(i = 0; entry; i++) {
+        if(entry->length) {
+            fprintf(file, "    %s(!script->check && strbuf_strcpy(strbuf, ", branch);
+            render_string(file, entry->string, entry->length);
+            fprintf(file, ", %zu)) {\n", entry->length);
+            fprintf(file, "        status = panic(\"failed to strcpy strbuf object\");\n");
+            branch = "} else if";
+        }
+
+        if(entry->identifier) {
+            fprintf(file, "    %s(render_load(&subset, stack, %zu", branch, entry->count);
+            for(j = 0; j < entry->count; j++)
+                fprintf(file, ", %ldL", entry->array[j]);
+            fprintf(file, ")) {\n");
+            fprintf(file, "        status = panic(\"failed to load entry node object\");\n");
+            branch = "} else if";
+
+            if(entry->callback) {
+                fprintf(file, "    } else if(argument_%s(script, &subset, NULL, strbuf)) {\n", entry->identifier);
+            } else if(render_inline(entry)) {
+                fprintf(file, "    } else if(render_integer(script, &subset, ");
+                render_flag(file, entry->argument->integer);
+                fprintf(file, ", strbuf)) {\n");
+            } else {
+                fprintf(file, "    } else if(entry_node_call(render_entry_at(argument, %zu, %zu), script, &subset, strbuf)) {\n", index, i);
+            }
+            fprintf(file, "        status = panic(\"failed to call entry node object\");\n");
+        }
+        entry = entry->next;
+    }
+
+    if(strcmp(branch, "if"))
+        fprintf(file, "    }\n\n");
+    fprintf(file, "    stack_destroy(&subset);\n\n    return status;\n}\n\n");
+}
+
+void render_string(FILE * file, char * string, size_t length) {
+    size_t i;
+    unsigned char c;
+
+    fputc('"', file);
+    for(i = 0; i < length; i++) {
+        c = string[i];
+        if(c == '"' || c == '\\' || c == '?') {
+            fprintf(file, "\\%c", c);
+        } else if(c < ' ' || c > '~') {
+            fprintf(file, "\\%03o", c);
+        } else {
+            fputc(c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+void render_flag(FILE * file, struct integer_node * integer) {
+    int count = 0;
+    long flag = integer ? integer->flag : 0;
+
+    if(flag & integer_sign)
+        fprintf(file, "%sinteger_sign", count++ ? " | " : "");
+    if(flag & integer_string)
+        fprintf(file, "%sinteger_string", count++ ? " | " : "");
+    if(flag & integer_percent)
+        fprintf(file, "%sinteger_percent", count++ ? " | " : "");
+    if(flag & integer_inverse)
+        fprintf(file, "%sinteger_inverse", count++ ? " | " : "");
+    if(flag & integer_absolute)
+        fprintf(file, "%sinteger_absolute", count++ ? " | " : "");
+    if(!count)
+        fprintf(file, "0");
+
+    fprintf(file, ", %ld", integer ? integer->divide : 0);
+}
@@ -0,0 +1,181 @@
+#include "ring.h"
+
+#include <errno.h>
+
+void * ring_drain(void *);
+int ring_wait(sem_t *);
+
+int ring_create(struct ring * ring, size_t count, size_t size, struct writer * writer) {
+    int status = 0;
+    size_t i;
+
+    if(!count || count & (count - 1)) {
+        status = panic("invalid count");
+    } else if(!size) {
+        status = panic("invalid size");
+    } else if(!writer) {
+        status = panic("invalid writer object");
+    } else {
+        ring->node = calloc(count, sizeof(*ring->node));
+        if(!ring->node) {
+            status = panic("out of memory");
+        } else {
+            for(i = 0; i < count && !status; i++) {
+                ring->node[i].buffer = malloc(size);
+                if(!ring->node[i].buffer)
+                    status = panic("out of memory");
+            }
+
+            if(status) {
+                goto buffer_fail;
+            } else if(sem_init(&ring->full, 0, 0)) {
+                status = panic("failed to create full semaphore");
+                goto buffer_fail;
+            } else if(sem_init(&ring->free, 0, count)) {
+                status = panic("failed to create free semaphore");
+                goto free_fail;
+            } else {
+                ring->writer = writer;
+                ring->count = count;
+                ring->size = size;
+                ring->held = 0;
+                atomic_init(&ring->head, 0);
+                atomic_init(&ring->tail, 0);
+                atomic_init(&ring->status, 0);
+
+                if(pthread_create(&ring->thread, NULL, ring_drain, ring)) {
+                    status = panic("failed to create thread");
+                    goto thread_fail;
+                }
+
+                ring->running = 1;
+            }
+        }
+    }
+
+    return status;
+
+thread_fail:
+    sem_destroy(&ring->free);
+free_fail:
+    sem_destroy(&ring->full);
+buffer_fail:
+    for(i = 0; i < count; i++)
+        free(ring->node[i].buffer);
+    free(ring->node);
+
+    return status;
+}
+
+void ring_destroy(struct ring * ring) {
+    size_t i;
+
+    ring_close(ring);
+    sem_destroy(&ring->free);
+    sem_destroy(&ring->full);
+    for(i = 0; i < ring->count; i++)
+        free(ring->node[i].buffer);
+    free(ring->node);
+}
+
+int ring_wait(sem_t * sem) {
+    while(sem_wait(sem))
+        if(errno != EINTR)
+            return 1;
+
+    return 0;
+}
+
+char * ring_acquire(struct ring * ring) {
+    size_t head;
+
+    if(!ring->held) {
+        if(ring_wait(&ring->free)) {
+            panic("failed to wait free semaphore");
+            return NULL;
+        }
+        ring->held = 1;
+    }
+
+    if(atomic_load_explicit(&ring->status, memory_order_relaxed)) {
+        panic("failed to write ring object");
+        return NULL;
+    }
+
+    head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+
+    return ring->node[head & (ring->count - 1)].buffer;
+}
+
+int ring_publish(struct ring * ring, size_t length) {
+    size_t head;
+
+    if(!ring->held && !ring_acquire(ring))
+        return panic("failed to acquire ring object");
+
+    head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    ring->node[head & (ring->count - 1)].length = length;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    ring->held = 0;
+
+    if(sem_post(&ring->full))
+        return panic("failed to post full semaphore");
+
+    return 0;
+}
+
+int ring_close(struct ring * ring) {
+    int status = 0;
+
+    if(!ring->running)
+        return 0;
+
+    /* an empty node stops the writer thread */
+    if(ring_publish(ring, 0))
+        status = panic("failed to publish ring object");
+
+    if(pthread_join(ring->thread, NULL))
+        status = panic("failed to join thread");
+
+    ring->running = 0;
+
+    if(atomic_load(&ring->status))
+        status = panic("failed to write ring object");
+
+    return status;
+}
+
+void * ring_drain(void * context) {
+    struct ring * ring = context;
+    struct ring_node * node;
+    size_t tail;
+
+    while(1) {
+        if(ring_wait(&ring->full)) {
+            panic("failed to wait full semaphore");
+            atomic_store(&ring->status, 1);
+            break;
+        }
+
+        tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        if(tail == atomic_load_explicit(&ring->head, memory_order_acquire))
+            continue;
+
+        node = &ring->node[tail & (ring->count - 1)];
+        if(!node->length)
+            break;
+
+        if(!atomic_load_explicit(&ring->status, memory_order_relaxed) && writer_write(ring->writer, node->buffer, node->length))
+            atomic_store(&ring->status, 1);
+
+        atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+
+        if(sem_post(&ring->free)) {
+            panic("failed to post free semaphore");
+            atomic_store(&ring->status, 1);
+            break;
+        }
+    }
+
+    return NULL;
+}
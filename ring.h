@@ -0,0 +1,36 @@
+#ifndef ring_h
+#define ring_h
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+
+#include "writer.h"
+
+struct ring_node {
+    char * buffer;
+    size_t length;
+};
+
+struct ring {
+    struct writer * writer;
+    struct ring_node * node;
+    size_t count;
+    size_t size;
+    atomic_size_t head;
+    atomic_size_t tail;
+    atomic_int status;
+    sem_t full;
+    sem_t free;
+    pthread_t thread;
+    int running;
+    int held;
+};
+
+int ring_create(struct ring *, size_t, size_t, struct writer *);
+void ring_destroy(struct ring *);
+char * ring_acquire(struct ring *);
+int ring_publish(struct ring *, size_t);
+int ring_close(struct ring *);
+
+#endif
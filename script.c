@@ -20,6 +20,16 @@ long ATF_SKILL;
 long ATF_TARGET;
 long ATF_WEAPON;
 
+int script_reference_node(struct script_tree *, script_reference_cb, void *);
+int script_branch_node(struct script_tree *, int);
+int script_branch_token(int);
+void script_reset(struct script *);
+void script_range_clear(struct script *);
+int script_budget(struct script *);
+int script_budget_fit(struct script *, size_t);
+size_t script_range_width(struct script_range *);
+typedef char * (* script_name_cb) (struct script *, void *, long);
+int script_range_name(struct script *, struct script_range *, struct strbuf *, char *, char *, script_name_cb, void *, size_t *);
 int table_set_constant(struct table *, char *, long *);
 
 int script_map_push(struct script *, struct map *);
@@ -38,22 +48,69 @@ int script_map_logic_push(struct script *, struct map *);
 void script_map_logic_pop(struct script *);
 
 struct script_range * script_range_create(struct script *, enum script_type, char *, ...);
+struct script_range * script_range_join(struct script *, enum script_type, char *, struct script_range *, struct script_range *);
+char * script_range_string(struct script *, struct script_range *);
+size_t script_range_length(struct script_range *);
+char * script_range_write(struct script_range *, char *);
+int script_stack_string(struct script *, struct stack *);
+int script_range_merge(struct script *, struct script_range **, struct script_range *);
+
+int script_summary_get(struct script *, struct callfunc_node *, struct stack *, struct script_summary **);
+int script_summary_key(struct strbuf *, struct stack *);
+int script_summary_create(struct script *, struct callfunc_node *, struct stack *, struct script_summary *);
+int script_summary_argument(struct script *, struct stack *);
+int script_summary_effect(struct script *, struct script *, struct script_summary *);
+int script_summary_load(struct script *, struct script_summary *, struct script_range **);
+int script_value_save(struct store *, char *, struct script_range *, struct script_value **);
+struct script_range * script_value_load(struct script *, struct script_value *);
 
 int script_logic_create(struct script *, struct logic_node *, struct map *);
+int script_logic_prune(struct script *, struct map *, struct map *);
+int script_logic_range(int, struct range *, struct range *, struct range *);
 int script_logic_cond(struct script *, struct script_range *, struct map *, range_cb);
 int script_logic_not_cond(struct script *, struct script_range *, struct map *, range_cb);
 
 enum script_flag {
     is_logic = 0x1,
     is_array = 0x2,
-    is_concat = 0x4
+    is_concat = 0x4,
+    is_true = 0x8,
+    is_false = 0x10
 };
 
-int script_generate(struct script *, char *, struct strbuf *);
+enum script_loop {
+    loop_union,
+    loop_widen,
+    loop_narrow
+};
+
+int script_generate(struct script *, struct script_node *, struct strbuf *);
 int script_parse(struct script *, char *);
+int script_parse_buffer(struct script *, char *);
+int script_scan(struct script *, char *, size_t);
+int script_layout(struct script *);
+int script_flatten(struct store *, struct script_tree *, struct script_node **);
+void script_flatten_size(struct script_tree *, size_t *, size_t *);
+struct script_node * script_flatten_node(struct script_tree *, struct script_node **, char **);
+int script_flatten_text(struct script_node *, char *, char **);
+int script_fold(struct script *, struct script_tree *);
+int script_fold_node(struct script *, struct script_tree *);
+int script_fold_integer(struct script *, struct script_tree *, long, char *);
+char * script_fold_string(struct script *, struct script_tree *);
 int script_translate(struct script *, struct script_node *);
 int script_translate_if(struct script *, struct script_node *, char *, ...);
+int script_translate_for(struct script *, struct script_node *);
+int script_loop_pass(struct script *, struct script_node *, struct script_code *);
+int script_loop_join(struct script *, struct map *, struct map *, int, int *);
+int script_loop_load(struct script *, struct map *);
+char * script_assign_key(struct script *, struct script_node *, struct script_range *);
 int script_evaluate(struct script *, struct script_node *, int, struct script_range **);
+int script_code_compile(struct store *, struct script_node *, struct script_code **);
+int script_code_opcode(struct script_node *, int);
+int script_code_arity(int);
+size_t script_code_size(struct script_node *, int);
+struct script_code * script_code_emit(struct script_node *, int, struct script_code *);
+int script_code_run(struct script *, struct script_code *, int, struct script_range **);
 struct script_range * script_execute(struct script *, struct stack *, struct argument_node *);
 int script_optional(struct script *, struct stack *, struct argument_node *);
 
@@ -69,6 +126,9 @@ struct script_range * function_bonus4(struct script *, struct stack *);
 struct script_range * function_bonus5(struct script *, struct stack *);
 struct script_range * function_getskilllv(struct script *, struct stack *);
 struct script_range * function_constant(struct script *, struct stack *);
+struct script_range * function_callfunc(struct script *, struct stack *);
+struct script_range * function_getarg(struct script *, struct stack *);
+struct script_range * function_return(struct script *, struct stack *);
 
 typedef struct script_range * (*function_cb) (struct script *, struct stack *);
 
@@ -91,11 +151,13 @@ struct function_entry {
     { "readparam", function_constant },
     { "vip_status", function_constant },
     { "checkoption", function_constant },
+    { "callfunc", function_callfunc },
+    { "getarg", function_getarg },
+    { "return", function_return },
     { NULL, NULL}
 };
 
 int entry_node_load(struct entry_node *, struct stack *, struct stack *);
-int entry_node_call(struct entry_node *, struct script *, struct stack *, struct strbuf *);
 int print_node_write(struct print_node *, struct script *, struct stack *, struct strbuf *);
 
 int argument_print(struct script *, struct stack *, struct argument_node *, struct strbuf *);
@@ -113,6 +175,12 @@ int argument_mob(struct script *, struct stack *, struct argument_node *, struct
 int argument_mercenary(struct script *, struct stack *, struct argument_node *, struct strbuf *);
 
 int argument_group(struct script *, struct stack *, struct strbuf *, char *);
+char * argument_array_name(struct script *, void *, long);
+char * argument_item_name(struct script *, void *, long);
+char * argument_skill_name(struct script *, void *, long);
+char * argument_mob_name(struct script *, void *, long);
+char * argument_mercenary_name(struct script *, void *, long);
+char * argument_group_name(struct script *, void *, long);
 int argument_element(struct script *, struct stack *, struct argument_node *, struct strbuf *);
 int argument_equip(struct script *, struct stack *, struct argument_node *, struct strbuf *);
 int argument_job(struct script *, struct stack *, struct argument_node *, struct strbuf *);
@@ -131,8 +199,6 @@ int argument_sc_start(struct script *, struct stack *, struct argument_node *, s
 int argument_sc_start2(struct script *, struct stack *, struct argument_node *, struct strbuf *);
 int argument_sc_start4(struct script *, struct stack *, struct argument_node *, struct strbuf *);
 
-typedef int (*argument_cb) (struct script *, struct stack *, struct argument_node *, struct strbuf *);
-
 struct argument_entry {
     char * identifier;
     argument_cb argument;
@@ -169,6 +235,13 @@ struct argument_entry {
     { NULL, NULL }
 };
 
+argument_cb argument_search(char *);
+int argument_bind(struct script *, struct locale *, struct argument *, char *, struct render_entry *);
+int argument_bind_optional(struct script *, struct argument *, struct optional_node *);
+void argument_bind_render(struct argument_node *, char *, struct render_entry *);
+unsigned long argument_hash(unsigned long, void *, size_t);
+unsigned long argument_hash_node(unsigned long, struct argument_node *);
+
 int script_buffer_create(struct script_buffer * buffer, size_t size, struct heap * heap) {
     int status = 0;
 
@@ -289,6 +362,11 @@ int undefined_add(struct undefined * undef, char * format, ...) {
     return status;
 }
 
+void undefined_clear(struct undefined * undef) {
+    map_clear(&undef->map);
+    store_clear(&undef->store);
+}
+
 void undefined_print(struct undefined * undef) {
     struct map_kv kv;
 
@@ -303,9 +381,13 @@ void undefined_print(struct undefined * undef) {
     }
 }
 
-int script_setup(struct table * table) {
+int script_setup(struct table * table, struct heap * heap, struct render_entry * render) {
     int status = 0;
 
+    size_t i;
+    struct locale * locale;
+    struct script script;
+
     if( table_set_constant(table, "BF_SHORT", &BF_SHORT) ||
         table_set_constant(table, "BF_LONG", &BF_LONG) ||
         table_set_constant(table, "BF_WEAPON", &BF_WEAPON) ||
@@ -320,8 +402,176 @@ int script_setup(struct table * table) {
         table_set_constant(table, "ATF_SHORT", &ATF_SHORT) ||
         table_set_constant(table, "ATF_SKILL", &ATF_SKILL) ||
         table_set_constant(table, "ATF_TARGET", &ATF_TARGET) ||
-        table_set_constant(table, "ATF_WEAPON", &ATF_WEAPON) )
+        table_set_constant(table, "ATF_WEAPON", &ATF_WEAPON) ) {
         status = panic("failed to set constant table object");
+    } else if(script_create(&script, 4096, heap, table)) {
+        status = panic("failed to create script object");
+    } else {
+        for(i = 0; i < table->count && !status; i++) {
+            locale = &table->locale[i];
+            if( argument_bind(&script, locale, &locale->argument, "argument", render) ||
+                argument_bind(&script, locale, &locale->bonus, "bonus", render) ||
+                argument_bind(&script, locale, &locale->bonus2, "bonus2", render) ||
+                argument_bind(&script, locale, &locale->bonus3, "bonus3", render) ||
+                argument_bind(&script, locale, &locale->bonus4, "bonus4", render) ||
+                argument_bind(&script, locale, &locale->bonus5, "bonus5", render) ||
+                argument_bind(&script, locale, &locale->sc_start, "sc_start", render) ||
+                argument_bind(&script, locale, &locale->sc_start2, "sc_start2", render) ||
+                argument_bind(&script, locale, &locale->sc_start4, "sc_start4", render) ||
+                argument_bind(&script, locale, &locale->statement, "statement", render) )
+                status = panic("failed to bind argument object");
+        }
+        script_destroy(&script);
+    }
+
+    return status;
+}
+
+argument_cb argument_search(char * identifier) {
+    struct argument_entry * argument;
+
+    argument = argument_list;
+    while(argument->identifier) {
+        if(!strcmp(argument->identifier, identifier))
+            return argument->argument;
+        argument++;
+    }
+
+    return NULL;
+}
+
+int argument_bind(struct script * script, struct locale * locale, struct argument * argument, char * name, struct render_entry * render) {
+    struct argument_node * node;
+    struct print_node * print;
+    struct entry_node * entry;
+
+    /* resolve handlers once instead of on every print */
+    node = argument->argument;
+    while(node) {
+        node->callback = node->handler ? argument_search(node->handler) : argument_print;
+        if(!node->callback)
+            return panic("invalid handler - %s", node->handler);
+
+        if(argument_bind_optional(script, argument, node->optional))
+            return panic("failed to bind optional argument object - %s", node->identifier);
+
+        print = node->print;
+        while(print) {
+            entry = print->entry;
+            while(entry) {
+                if(entry->identifier) {
+                    entry->callback = argument_search(entry->identifier);
+                    if(!entry->callback)
+                        entry->argument = map_search(&locale->argument.identifier, entry->identifier);
+                }
+                entry = entry->next;
+            }
+            print = print->next;
+        }
+
+        if(render)
+            argument_bind_render(node, name, render);
+        node = node->next;
+    }
+
+    return 0;
+}
+
+void argument_bind_render(struct argument_node * node, char * name, struct render_entry * render) {
+    unsigned long digest;
+
+    /* a generated renderer is only used for the template it was generated from */
+    digest = argument_digest(node);
+    while(render->table) {
+        if(render->digest == digest && !strcmp(render->table, name) && !strcmp(render->identifier, node->identifier)) {
+            node->callback = render->render;
+            break;
+        }
+        render++;
+    }
+}
+
+unsigned long argument_digest(struct argument_node * argument) {
+    unsigned long hash = 14695981039346656037UL;
+    struct print_node * print;
+    struct entry_node * entry;
+
+    hash = argument_hash_node(hash, argument);
+
+    print = argument->print;
+    while(print) {
+        hash = argument_hash(hash, "\n", 1);
+        entry = print->entry;
+        while(entry) {
+            hash = argument_hash(hash, &entry->length, sizeof(entry->length));
+            hash = argument_hash(hash, entry->string, entry->length);
+            if(entry->identifier) {
+                hash = argument_hash(hash, entry->identifier, strlen(entry->identifier) + 1);
+                hash = argument_hash(hash, &entry->count, sizeof(entry->count));
+                hash = argument_hash(hash, entry->array, entry->count * sizeof(*entry->array));
+                if(entry->callback) {
+                    hash = argument_hash(hash, "c", 1);
+                } else if(entry->argument) {
+                    hash = argument_hash(hash, "a", 1);
+                    hash = argument_hash_node(hash, entry->argument);
+                }
+            }
+            entry = entry->next;
+        }
+        print = print->next;
+    }
+
+    return hash;
+}
+
+unsigned long argument_hash(unsigned long hash, void * data, size_t length) {
+    size_t i;
+    unsigned char * byte = data;
+
+    for(i = 0; i < length; i++) {
+        hash ^= byte[i];
+        hash *= 1099511628211UL;
+    }
+
+    return hash;
+}
+
+unsigned long argument_hash_node(unsigned long hash, struct argument_node * argument) {
+    char * handler;
+    long integer[2] = { 0, 0 };
+
+    handler = argument->handler ? argument->handler : "";
+    if(argument->integer) {
+        integer[0] = argument->integer->flag;
+        integer[1] = argument->integer->divide;
+    }
+
+    hash = argument_hash(hash, handler, strlen(handler) + 1);
+    hash = argument_hash(hash, integer, sizeof(integer));
+    hash = argument_hash(hash, argument->optional ? "o" : "", 1);
+
+    return hash;
+}
+
+int argument_bind_optional(struct script * script, struct argument * argument, struct optional_node * optional) {
+    int status = 0;
+
+    /* default values are parsed once into the argument store */
+    while(optional && !status) {
+        script_reset(script);
+
+        if(script_parse(script, optional->string)) {
+            status = panic("failed to parse script object");
+        } else if(script_flatten(&argument->store, script->tree, &optional->root)) {
+            status = panic("failed to flatten script object");
+        } else if(script_code_compile(&argument->store, script_node_root(optional->root), &optional->code)) {
+            status = panic("failed to compile script object");
+        }
+
+        store_clear(&script->store);
+
+        optional = optional->next;
+    }
 
     return status;
 }
@@ -330,10 +580,10 @@ int script_create(struct script * script, size_t size, struct heap * heap, struc
     int status = 0;
 
     struct function_entry * function;
-    struct argument_entry * argument;
 
     script->heap = heap;
     script->table = table;
+    script->check = 0;
 
     if(!script->heap) {
         status = panic("invalid heap object");
@@ -349,6 +599,14 @@ int script_create(struct script * script, size_t size, struct heap * heap, struc
         } else if(store_create(&script->store, size)) {
             status = panic("failed to create store object");
             goto store_fail;
+        } else if(zone_create(&script->zone, size)) {
+            status = panic("failed to create zone object");
+            goto zone_fail;
+        } else if( pool_create_zone(&script->range_pool, sizeof(struct range_node), &script->zone) ||
+                   pool_create_zone(&script->logic_pool, sizeof(struct logic_node), &script->zone) ||
+                   pool_create_zone(&script->map_pool, sizeof(struct map_node), &script->zone) ) {
+            status = panic("failed to create pool object");
+            goto pool_fail;
         } else if(stack_create(&script->map_stack, heap->stack_pool)) {
             status = panic("failed to create stack object");
             goto map_fail;
@@ -367,16 +625,25 @@ int script_create(struct script * script, size_t size, struct heap * heap, struc
         } else if(map_create(&script->function, (map_compare_cb) strcmp, heap->map_pool)) {
             status = panic("failed to create map object");
             goto function_fail;
-        } else if(map_create(&script->argument, (map_compare_cb) strcmp, heap->map_pool)) {
-            status = panic("failed to create map object");
-            goto argument_fail;
         } else if(script_buffer_create(&script->buffer, size, heap)) {
             status = panic("failed to create script buffer object");
             goto buffer_fail;
         } else if(undefined_create(&script->undefined, size, heap)) {
             status = panic("failed to create undefined object");
             goto undef_fail;
+        } else if(store_create(&script->summary_store, size)) {
+            status = panic("failed to create store object");
+            goto summary_store_fail;
+        } else if(map_create(&script->summary, (map_compare_cb) strcmp, heap->map_pool)) {
+            status = panic("failed to create map object");
+            goto summary_fail;
         } else {
+            script->callee = NULL;
+            script->argument = NULL;
+            script->argument_count = 0;
+            script->result = NULL;
+            script->depth = 0;
+
             function = function_list;
             while(function->identifier && !status) {
                 if(map_insert(&script->function, function->identifier, function->function)) {
@@ -386,15 +653,6 @@ int script_create(struct script * script, size_t size, struct heap * heap, struc
                 }
             }
 
-            argument = argument_list;
-            while(argument->identifier && !status) {
-                if(map_insert(&script->argument, argument->identifier, argument->argument)) {
-                    status = panic("failed to insert map object");
-                } else {
-                    argument++;
-                }
-            }
-
             if(status)
                 goto script_fail;
         }
@@ -403,12 +661,14 @@ int script_create(struct script * script, size_t size, struct heap * heap, struc
     return status;
 
 script_fail:
+    map_destroy(&script->summary);
+summary_fail:
+    store_destroy(&script->summary_store);
+summary_store_fail:
     undefined_destroy(&script->undefined);
 undef_fail:
     script_buffer_destroy(&script->buffer);
 buffer_fail:
-    map_destroy(&script->argument);
-argument_fail:
     map_destroy(&script->function);
 function_fail:
     stack_destroy(&script->map_logic_stack);
@@ -421,6 +681,9 @@ stack_fail:
 logic_fail:
     stack_destroy(&script->map_stack);
 map_fail:
+pool_fail:
+    zone_destroy(&script->zone);
+zone_fail:
     store_destroy(&script->store);
 store_fail:
     scriptpstate_delete(script->parser);
@@ -431,15 +694,21 @@ parser_fail:
 }
 
 void script_destroy(struct script * script) {
+    if(script->callee) {
+        script_destroy(script->callee);
+        free(script->callee);
+    }
+    map_destroy(&script->summary);
+    store_destroy(&script->summary_store);
     undefined_destroy(&script->undefined);
     script_buffer_destroy(&script->buffer);
-    map_destroy(&script->argument);
     map_destroy(&script->function);
     stack_destroy(&script->map_logic_stack);
     stack_destroy(&script->strbuf_stack);
     stack_destroy(&script->stack_stack);
     stack_destroy(&script->logic_stack);
     stack_destroy(&script->map_stack);
+    zone_destroy(&script->zone);
     store_destroy(&script->store);
     scriptpstate_delete(script->parser);
     scriptlex_destroy(script->scanner);
@@ -450,25 +719,270 @@ int script_compile(struct script * script, char * string, struct strbuf * strbuf
 
     strbuf_clear(strbuf);
 
+    script_reset(script);
+
+    script->output = strbuf;
+
+    if(script_parse_buffer(script, string)) {
+        status = panic("failed to parse script object");
+    } else if(script_generate(script, script->root, strbuf)) {
+        status = panic("failed to compile script object");
+    }
+
+    script_range_clear(script);
+
+    store_clear(&script->store);
+
+    return status;
+}
+
+int script_compile_locale(struct script * script, char * string, struct strbuf * strbuf, size_t count) {
+    int status = 0;
+
+    size_t i;
+    struct script_node * root;
+
+    for(i = 0; i < count; i++)
+        strbuf_clear(&strbuf[i]);
+
+    script_reset(script);
+
+    if(script_parse_buffer(script, string)) {
+        status = panic("failed to parse script object");
+    } else {
+        root = script->root;
+        for(i = 0; i < count && !status; i++) {
+            script->output = &strbuf[i];
+            script->step = 0;
+            script->exhausted = 0;
+
+            if(table_locale_set(script->table, i)) {
+                status = panic("failed to locale set table object");
+            } else if(script_generate(script, root, &strbuf[i])) {
+                status = panic("failed to compile script object");
+            }
+            script_range_clear(script);
+        }
+    }
+
+    store_clear(&script->store);
+
+    return status;
+}
+
+int script_reference(struct script * script, char * string, script_reference_cb cb, void * context) {
+    int status = 0;
+
+    script_reset(script);
+
+    /* the tree is walked as parsed so that folded calls are still seen */
+    if(script_scan(script, string, strlen(string) + 2)) {
+        status = panic("failed to scan script object");
+    } else if(script_reference_node(script->tree, cb, context)) {
+        status = panic("failed to reference script object");
+    }
+
+    store_clear(&script->store);
+
+    return status;
+}
+
+int script_reference_node(struct script_tree * root, script_reference_cb cb, void * context) {
+    while(root) {
+        if(root->token == script_identifier && cb(root->identifier, context))
+            return panic("failed to reference identifier - %s", root->identifier);
+
+        if(script_reference_node(root->root, cb, context))
+            return 1;
+
+        root = root->next;
+    }
+
+    return 0;
+}
+
+int script_branch(struct script * script, char * string, int * result) {
+    int status = 0;
+
+    script_reset(script);
+
+    if(script_scan(script, string, strlen(string) + 2)) {
+        status = panic("failed to scan script object");
+    } else {
+        *result = script_branch_node(script->tree, 0);
+    }
+
+    store_clear(&script->store);
+
+    return status;
+}
+
+int script_branch_node(struct script_tree * root, int branch) {
+    while(root) {
+        if(root->token == script_curly_open) {
+            /* the statements of a block are not part of its condition */
+            if(script_branch_node(root->root, 0))
+                return 1;
+        } else {
+            /* a literal or a variable under a condition may decide a branch */
+            if(branch && (root->token == script_integer || root->token == script_identifier))
+                return 1;
+
+            /* the body of a called function is not in the tree */
+            if(root->token == script_identifier && !strcmp(root->identifier, "callfunc"))
+                return 1;
+
+            if(script_branch_node(root->root, branch || script_branch_token(root->token)))
+                return 1;
+        }
+
+        root = root->next;
+    }
+
+    return 0;
+}
+
+int script_branch_token(int token) {
+    switch(token) {
+        case script_if:
+        case script_else:
+        case script_for:
+        case script_question:
+        case script_or:
+        case script_and:
+        case script_not:
+        case script_equal:
+        case script_not_equal:
+        case script_lesser:
+        case script_lesser_equal:
+        case script_greater:
+        case script_greater_equal:
+            return 1;
+    }
+
+    return 0;
+}
+
+void script_reset(struct script * script) {
+    script->tree = NULL;
     script->root = NULL;
     script->map = NULL;
     script->logic = NULL;
     script->stack = NULL;
     script->strbuf = NULL;
     script->map_logic = NULL;
-    script->range = NULL;
+    script->output = NULL;
+    script->result = NULL;
+    script->step = 0;
+    script->exhausted = 0;
+}
 
-    if(script_generate(script, string, strbuf))
-        status = panic("failed to compile script object");
+void script_range_clear(struct script * script) {
+    /* the nodes of the ranges, the logic and the maps go back with the zone */
+    pool_clear(&script->range_pool);
+    pool_clear(&script->logic_pool);
+    pool_clear(&script->map_pool);
+    zone_clear(&script->zone);
+}
+
+int script_budget(struct script * script) {
+    size_t length;
+    struct strbuf * strbuf;
 
-    while(script->range) {
-        range_destroy(script->range->range);
-        script->range = script->range->next;
+    if(!script->exhausted) {
+        if(script->step > SCRIPT_BUDGET_STEP) {
+            script->exhausted = 1;
+        } else if(script->strbuf) {
+            /* the blocks that are being translated end up in the output */
+            length = script->strbuf->pos - script->strbuf->str;
+            strbuf = stack_start(&script->strbuf_stack);
+            while(strbuf) {
+                length += strbuf->pos - strbuf->str;
+                strbuf = stack_next(&script->strbuf_stack);
+            }
+
+            if(length > SCRIPT_BUDGET_OUTPUT)
+                script->exhausted = 1;
+        }
     }
 
-    store_clear(&script->store);
+    return script->exhausted;
+}
 
-    return status;
+int script_budget_fit(struct script * script, size_t length) {
+    /* an effect that does not fit in the strbuf is left out like the ones past the budget */
+    if((size_t) (script->strbuf->end - script->strbuf->pos) < length + SCRIPT_BUDGET_RESERVE) {
+        script->exhausted = 1;
+        return 0;
+    }
+
+    return 1;
+}
+
+size_t script_range_width(struct script_range * range) {
+    size_t span;
+    size_t width = 0;
+    struct range_node * node;
+
+    /* saturate so that a range over every long is over budget */
+    node = range->range->root;
+    while(node) {
+        span = (size_t) node->max - (size_t) node->min + 1;
+        if(!span || span > SIZE_MAX - width)
+            return SIZE_MAX;
+        width += span;
+        node = node->next;
+    }
+
+    return width;
+}
+
+int script_range_name(struct script * script, struct script_range * range, struct strbuf * strbuf, char * start, char * type, script_name_cb cb, void * context, size_t * count) {
+    long i;
+    size_t width;
+    size_t length;
+    char * anchor;
+    char * name;
+    struct range_node * node;
+
+    anchor = strbuf->pos;
+
+    width = script_range_width(range);
+    if(width <= SCRIPT_BUDGET_WIDTH) {
+        node = range->range->root;
+        while(node) {
+            for(i = node->min; ; i++) {
+                name = cb(script, context, i);
+                if(!name)
+                    return panic("failed to name range script object");
+
+                /* the list is summarised once it does not fit */
+                length = strlen(name) + 2;
+                if((size_t) (strbuf->pos - start) + length > SCRIPT_BUDGET_LIST)
+                    goto summary;
+
+                if(strbuf_strcpy(strbuf, name, length - 2) || strbuf_strcpy(strbuf, ", ", 2))
+                    return panic("failed to strcpy strbuf object");
+                (*count)++;
+
+                if(i == node->max)
+                    break;
+            }
+            node = node->next;
+        }
+
+        return 0;
+    }
+
+summary:
+    if(strbuf_unputn(strbuf, strbuf->pos - anchor))
+        return panic("failed to unputn strbuf object");
+
+    if(strbuf_printf(strbuf, "one of %zu %s, ", width, type))
+        return panic("failed to printf strbuf object");
+    (*count)++;
+
+    return 0;
 }
 
 int table_set_constant(struct table * table, char * identifier, long * result) {
@@ -495,7 +1009,7 @@ int script_map_push(struct script * script, struct map * map) {
             script->map = map;
         }
     } else {
-        if(map_create(map, (map_compare_cb) strcmp, script->heap->map_pool)) {
+        if(map_create(map, (map_compare_cb) strcmp, &script->map_pool)) {
             status = panic("failed to create map object");
         } else {
             script->map = map;
@@ -523,7 +1037,7 @@ int script_logic_push(struct script * script, struct logic * logic) {
             script->logic = logic;
         }
     } else {
-        if(logic_create(logic, script->heap->logic_pool)) {
+        if(logic_create(logic, &script->logic_pool)) {
             status = panic("failed to create logic object");
         } else {
             if(logic_push(logic, or, NULL)) {
@@ -623,11 +1137,30 @@ void script_map_logic_pop(struct script * script) {
 }
 
 struct script_range * script_range_create(struct script * script, enum script_type type, char * format, ...) {
-    int status = 0;
     va_list vararg;
     struct script_range * range;
 
+    range = script_range_join(script, type, NULL, NULL, NULL);
+    if(!range)
+        return NULL;
+
     va_start(vararg, format);
+    range->string = store_vprintf(&script->store, format, vararg);
+    va_end(vararg);
+
+    if(!range->string) {
+        panic("failed to vprintf store object");
+        return NULL;
+    }
+
+    range->length = strlen(range->string);
+
+    return range;
+}
+
+struct script_range * script_range_join(struct script * script, enum script_type type, char * format, struct script_range * x, struct script_range * y) {
+    int status = 0;
+    struct script_range * range;
 
     range = store_malloc(&script->store, sizeof(*range));
     if(!range) {
@@ -637,64 +1170,451 @@ struct script_range * script_range_create(struct script * script, enum script_ty
         range->range = store_malloc(&script->store, sizeof(*range->range));
         if(!range->range) {
             status = panic("failed to object store object");
+        } else if(range_create(range->range, &script->range_pool)) {
+            status = panic("failed to create range object");
         } else {
-            if(range_create(range->range, script->heap->range_pool)) {
-                status = panic("failed to create range object");
-            } else {
-                range->string = store_vprintf(&script->store, format, vararg);
-                if(!range->string) {
-                    status = panic("failed to vprintf store object");
-                } else {
-                    range->next = script->range;
-                    script->range = range;
-                }
-                if(status)
-                    range_destroy(range->range);
-            }
+            /* the string is written from the format and the children when it is read */
+            range->string = NULL;
+            range->length = 0;
+            range->format = format;
+            range->left = x;
+            range->right = y;
         }
     }
 
-    va_end(vararg);
-
     return status ? NULL : range;
 }
 
-int script_logic_create(struct script * script, struct logic_node * root, struct map * result) {
-    int status = 0;
+char * script_range_string(struct script * script, struct script_range * range) {
+    char * string;
 
-    struct map map;
-    struct script_range * range;
+    if(!range->string) {
+        range->length = script_range_length(range);
 
-    if(map_create(result, (map_compare_cb) strcmp, script->heap->map_pool)) {
-        status = panic("failed to create map object");
-    } else {
-        if(root->type == not || root->type == and) {
-            root = root->root;
-            while(root && !status) {
-                if(root->type == cond) {
-                    if(script_logic_cond(script, root->data, result, range_and))
-                        status = panic("failed to logic cond script object");
-                } else if(root->type == not_cond) {
-                    if(script_logic_not_cond(script, root->data, result, range_and))
-                        status = panic("failed to logic not cond script object");
-                } else {
-                    status = panic("invalid logic type");
-                }
-                root = root->next;
-            }
-        } else if(root->type == or || root->type == and_or) {
-            root = root->root;
-            while(root && !status) {
-                if(root->type == and) {
-                    if(script_logic_create(script, root, &map)) {
+        string = store_malloc(&script->store, range->length + 1);
+        if(!string) {
+            panic("failed to malloc store object");
+            return NULL;
+        }
+
+        *script_range_write(range, string) = 0;
+        range->string = string;
+    }
+
+    return range->string;
+}
+
+size_t script_range_length(struct script_range * range) {
+    size_t length = 0;
+    char * format;
+    struct script_range * child;
+
+    if(range->string)
+        return range->length;
+
+    child = range->left;
+    format = range->format;
+    while(*format) {
+        if(format[0] == '%' && format[1] == 's') {
+            length += script_range_length(child);
+            child = range->right;
+            format += 2;
+        } else {
+            if(format[0] == '%')
+                format++;
+            length++;
+            format++;
+        }
+    }
+
+    return length;
+}
+
+char * script_range_write(struct script_range * range, char * cursor) {
+    char * format;
+    struct script_range * child;
+
+    if(range->string) {
+        memcpy(cursor, range->string, range->length);
+        return cursor + range->length;
+    }
+
+    child = range->left;
+    format = range->format;
+    while(*format) {
+        if(format[0] == '%' && format[1] == 's') {
+            cursor = script_range_write(child, cursor);
+            child = range->right;
+            format += 2;
+        } else {
+            if(format[0] == '%')
+                format++;
+            *cursor++ = *format++;
+        }
+    }
+
+    return cursor;
+}
+
+int script_stack_string(struct script * script, struct stack * stack) {
+    size_t i;
+    struct script_range * range;
+
+    /* the handlers read the strings of their arguments */
+    for(i = 0; (range = stack_get(stack, i)); i++)
+        if(!script_range_string(script, range))
+            return panic("failed to string range script object");
+
+    return 0;
+}
+
+int script_range_merge(struct script * script, struct script_range ** result, struct script_range * x) {
+    struct script_range * y;
+    struct script_range * range;
+
+    y = *result;
+    if(!y) {
+        *result = x;
+        return 0;
+    }
+
+    range = script_range_join(script, y->type, "%s, %s", y, x);
+    if(!range)
+        return panic("failed to range script object");
+
+    /* a value that is not known keeps the merge unknown */
+    if(y->range->root && x->range->root && range_or(range->range, y->range, x->range))
+        return panic("failed to or range object");
+
+    *result = range;
+
+    return 0;
+}
+
+int script_summary_get(struct script * script, struct callfunc_node * callfunc, struct stack * stack, struct script_summary ** result) {
+    int status = 0;
+
+    char * key;
+    struct strbuf * strbuf;
+    struct script_summary * summary;
+
+    strbuf = script_buffer_get(&script->buffer);
+    if(!strbuf) {
+        status = panic("failed to get script buffer object");
+    } else {
+        /* the description depends on the locale and the arguments */
+        if(strbuf_printf(strbuf, "%zu:%s", (size_t) (script->table->current - script->table->locale), callfunc->identifier)) {
+            status = panic("failed to printf strbuf object");
+        } else if(script_summary_key(strbuf, stack)) {
+            status = panic("failed to summary key script object");
+        } else if(!(key = strbuf_array(strbuf))) {
+            status = panic("failed to array strbuf object");
+        } else {
+            summary = map_search(&script->summary, key);
+            if(!summary) {
+                summary = store_calloc(&script->summary_store, sizeof(*summary));
+                if(!summary) {
+                    status = panic("failed to calloc store object");
+                } else if(!(key = store_strcpy(&script->summary_store, key, strlen(key)))) {
+                    status = panic("failed to strcpy store object");
+                } else if(script_summary_create(script, callfunc, stack, summary)) {
+                    status = panic("failed to summary create script object");
+                } else if(map_insert(&script->summary, key, summary)) {
+                    status = panic("failed to insert map object");
+                }
+            }
+            *result = summary;
+        }
+        script_buffer_put(&script->buffer, strbuf);
+    }
+
+    return status;
+}
+
+int script_summary_key(struct strbuf * strbuf, struct stack * stack) {
+    size_t i;
+    struct range_node * node;
+    struct script_range * range;
+
+    for(i = 1; (range = stack_get(stack, i)); i++) {
+        if(strbuf_printf(strbuf, "|%d:%zu:%s:", range->type, strlen(range->string), range->string))
+            return panic("failed to printf strbuf object");
+
+        node = range->range->root;
+        while(node) {
+            if(strbuf_printf(strbuf, "%ld~%ld,", node->min, node->max))
+                return panic("failed to printf strbuf object");
+            node = node->next;
+        }
+    }
+
+    return 0;
+}
+
+int script_summary_create(struct script * script, struct callfunc_node * callfunc, struct stack * stack, struct script_summary * summary) {
+    int status = 0;
+
+    struct map map;
+    struct map_kv kv;
+    struct script * callee;
+    struct strbuf * strbuf;
+
+    /* the body is translated by a script of its own so that the caller's ranges and conditions do not leak in */
+    if(!script->callee) {
+        callee = malloc(sizeof(*callee));
+        if(!callee) {
+            return panic("out of memory");
+        } else if(script_create(callee, 4096, script->heap, script->table)) {
+            free(callee);
+            return panic("failed to create script object");
+        }
+        callee->depth = script->depth + 1;
+        script->callee = callee;
+    }
+
+    callee = script->callee;
+
+    strbuf = script_buffer_get(&script->buffer);
+    if(!strbuf) {
+        status = panic("failed to get script buffer object");
+    } else {
+        script_reset(callee);
+        callee->output = strbuf;
+
+        if(script_parse(callee, callfunc->script)) {
+            /* a function that does not parse is reported and left empty */
+            panic("failed to parse function - %s", callfunc->identifier);
+        } else if(script_summary_argument(callee, stack)) {
+            status = panic("failed to summary argument script object");
+        } else if(script_strbuf_push(callee, strbuf)) {
+            status = panic("failed to strbuf push script object");
+        } else {
+            if(script_map_push(callee, &map)) {
+                status = panic("failed to map push script object");
+            } else {
+                if(script_translate(callee, callee->root)) {
+                    status = panic("failed to translate script object");
+                } else if(script_summary_effect(script, callee, summary)) {
+                    status = panic("failed to summary effect script object");
+                }
+                script_map_pop(callee);
+            }
+            script_strbuf_pop(callee);
+        }
+
+        if(!status) {
+            strbuf_trim(strbuf);
+            summary->step = callee->step;
+            summary->string = store_strcpy(&script->summary_store, strbuf->str, strbuf->pos - strbuf->str);
+            if(!summary->string)
+                status = panic("failed to strcpy store object");
+        }
+
+        script_range_clear(callee);
+        store_clear(&callee->store);
+        script_buffer_put(&script->buffer, strbuf);
+
+        kv = map_start(&callee->undefined.map);
+        while(kv.key && !status) {
+            if(undefined_add(&script->undefined, "%s", (char *) kv.key))
+                status = panic("failed to add undefined object");
+            kv = map_next(&callee->undefined.map);
+        }
+    }
+
+    return status;
+}
+
+int script_summary_argument(struct script * script, struct stack * stack) {
+    size_t i;
+    struct script_range * x;
+    struct script_range * range;
+
+    script->result = NULL;
+    script->argument_count = 0;
+    while(stack_get(stack, script->argument_count + 1))
+        script->argument_count++;
+
+    script->argument = store_malloc(&script->store, sizeof(*script->argument) * (script->argument_count + 1));
+    if(!script->argument)
+        return panic("failed to malloc store object");
+
+    for(i = 0; i < script->argument_count; i++) {
+        x = stack_get(stack, i + 1);
+        range = script_range_join(script, x->type, "%s", x, NULL);
+        if(!range) {
+            return panic("failed to range script object");
+        } else if(range_assign(range->range, x->range)) {
+            return panic("failed to assign range object");
+        }
+        script->argument[i] = range;
+    }
+
+    return 0;
+}
+
+int script_summary_effect(struct script * script, struct script * callee, struct script_summary * summary) {
+    struct map_kv kv;
+    struct script_value * value;
+
+    kv = map_start(callee->map);
+    while(kv.key) {
+        /* the variables of the function scope stay behind */
+        if(strncmp(kv.key, ".@", 2)) {
+            if(!script_range_string(callee, kv.value))
+                return panic("failed to string range script object");
+            if(script_value_save(&script->summary_store, kv.key, kv.value, &value))
+                return panic("failed to value save script object");
+            value->next = summary->effect;
+            summary->effect = value;
+        }
+        kv = map_next(callee->map);
+    }
+
+    if(callee->result && !script_range_string(callee, callee->result))
+        return panic("failed to string range script object");
+
+    if(callee->result && script_value_save(&script->summary_store, NULL, callee->result, &summary->result))
+        return panic("failed to value save script object");
+
+    return 0;
+}
+
+int script_summary_load(struct script * script, struct script_summary * summary, struct script_range ** result) {
+    struct script_value * value;
+    struct script_range * range;
+
+    if(*summary->string && script_budget_fit(script, strlen(summary->string) + 1) && strbuf_printf(script->strbuf, "%s\n", summary->string))
+        return panic("failed to printf strbuf object");
+
+    /* the replay costs what the translation did */
+    script->step += summary->step;
+
+    value = summary->effect;
+    while(value) {
+        range = script_value_load(script, value);
+        if(!range) {
+            return panic("failed to value load script object");
+        } else if(map_insert(script->map, value->identifier, range)) {
+            return panic("failed to map insert script object");
+        }
+        value = value->next;
+    }
+
+    if(summary->result) {
+        *result = script_value_load(script, summary->result);
+        if(!*result)
+            return panic("failed to value load script object");
+    }
+
+    return 0;
+}
+
+int script_value_save(struct store * store, char * identifier, struct script_range * range, struct script_value ** result) {
+    struct script_value * value;
+    struct range_node * iter;
+    struct range_node * node;
+    struct range_node ** last;
+
+    value = store_calloc(store, sizeof(*value));
+    if(!value)
+        return panic("failed to calloc store object");
+
+    value->type = range->type;
+
+    if(identifier) {
+        value->identifier = store_strcpy(store, identifier, strlen(identifier));
+        if(!value->identifier)
+            return panic("failed to strcpy store object");
+    }
+
+    value->string = store_strcpy(store, range->string, strlen(range->string));
+    if(!value->string)
+        return panic("failed to strcpy store object");
+
+    last = &value->range;
+    iter = range->range->root;
+    while(iter) {
+        node = store_calloc(store, sizeof(*node));
+        if(!node)
+            return panic("failed to calloc store object");
+
+        node->min = iter->min;
+        node->max = iter->max;
+        *last = node;
+        last = &node->next;
+        iter = iter->next;
+    }
+
+    *result = value;
+
+    return 0;
+}
+
+struct script_range * script_value_load(struct script * script, struct script_value * value) {
+    struct script_range * range;
+    struct range_node * node;
+
+    range = script_range_create(script, value->type, "%s", value->string);
+    if(!range)
+        return NULL;
+
+    node = value->range;
+    while(node) {
+        if(range_add(range->range, node->min, node->max))
+            return NULL;
+        node = node->next;
+    }
+
+    return range;
+}
+
+int script_logic_create(struct script * script, struct logic_node * root, struct map * result) {
+    int status = 0;
+
+    struct map map;
+    struct logic_node * first;
+    struct script_range * range;
+
+    if(map_create(result, (map_compare_cb) strcmp, &script->map_pool)) {
+        status = panic("failed to create map object");
+    } else {
+        if(root->type == not || root->type == and) {
+            root = root->root;
+            while(root && !status) {
+                if(root->type == cond) {
+                    if(script_logic_cond(script, root->data, result, range_and))
+                        status = panic("failed to logic cond script object");
+                } else if(root->type == not_cond) {
+                    if(script_logic_not_cond(script, root->data, result, range_and))
+                        status = panic("failed to logic not cond script object");
+                } else {
+                    status = panic("invalid logic type");
+                }
+                root = root->next;
+            }
+        } else if(root->type == or || root->type == and_or) {
+            first = root->root;
+            root = root->root;
+            while(root && !status) {
+                if(root->type == and) {
+                    if(script_logic_create(script, root, &map)) {
                         status = panic("failed to logic map script object");
                     } else {
                         range = map_start(&map).value;
                         while(range && !status) {
-                            if(script_logic_cond(script, range, result, range_or))
+                            /* an identifier missing from an earlier branch is not narrowed */
+                            if(root != first && !map_search(result, range->string)) {
+                                /* skip */
+                            } else if(script_logic_cond(script, range, result, range_or)) {
                                 status = panic("failed to logic or cond script object");
+                            }
                             range = map_next(&map).value;
                         }
+
+                        if(!status && root != first && script_logic_prune(script, result, &map))
+                            status = panic("failed to logic prune script object");
+
                         map_destroy(&map);
                     }
                 } else {
@@ -712,13 +1632,135 @@ int script_logic_create(struct script * script, struct logic_node * root, struct
     return status;
 }
 
+int script_logic_prune(struct script * script, struct map * result, struct map * map) {
+    int status = 0;
+
+    char * key;
+    struct stack stack;
+    struct script_range * range;
+
+    /* drop identifiers that a branch does not narrow */
+    if(stack_create(&stack, script->heap->stack_pool)) {
+        status = panic("failed to create stack object");
+    } else {
+        range = map_start(result).value;
+        while(range && !status) {
+            if(!map_search(map, range->string) && stack_push(&stack, range->string))
+                status = panic("failed to push stack object");
+            range = map_next(result).value;
+        }
+
+        key = stack_pop(&stack);
+        while(key && !status) {
+            if(map_delete(result, key)) {
+                status = panic("failed to delete map object");
+            } else {
+                key = stack_pop(&stack);
+            }
+        }
+
+        stack_destroy(&stack);
+    }
+
+    return status;
+}
+
+int script_logic_range(int token, struct range * x, struct range * y, struct range * range) {
+    long min;
+    long max;
+    long x_min;
+    long x_max;
+    long y_min;
+    long y_max;
+
+    min = 0;
+    max = 1;
+
+    /* decide the condition when the operands are known */
+    switch(token) {
+        case script_or:
+        case script_and:
+            range_truth(x, &x_min, &x_max);
+            range_truth(y, &y_min, &y_max);
+            if(token == script_or) {
+                min = x_min || y_min;
+                max = x_max || y_max;
+            } else {
+                min = x_min && y_min;
+                max = x_max && y_max;
+            }
+            break;
+        case script_not:
+            range_truth(x, &x_min, &x_max);
+            min = !x_max;
+            max = !x_min;
+            break;
+        default:
+            if(!x->root || !y->root)
+                break;
+
+            switch(token) {
+                case script_equal:
+                case script_not_equal:
+                    if(!range_overlap(x, y)) {
+                        max = 0;
+                    } else if(x->min == x->max && y->min == y->max) {
+                        min = 1;
+                    }
+
+                    if(token == script_not_equal) {
+                        x_min = min;
+                        min = !max;
+                        max = !x_min;
+                    }
+                    break;
+                case script_lesser:
+                    if(x->min >= y->max) {
+                        max = 0;
+                    } else if(x->max < y->min) {
+                        min = 1;
+                    }
+                    break;
+                case script_lesser_equal:
+                    if(x->min > y->max) {
+                        max = 0;
+                    } else if(x->max <= y->min) {
+                        min = 1;
+                    }
+                    break;
+                case script_greater:
+                    if(x->max <= y->min) {
+                        max = 0;
+                    } else if(x->min > y->max) {
+                        min = 1;
+                    }
+                    break;
+                case script_greater_equal:
+                    if(x->max < y->min) {
+                        max = 0;
+                    } else if(x->min >= y->max) {
+                        min = 1;
+                    }
+                    break;
+            }
+            break;
+    }
+
+    return range_add(range, min, max);
+}
+
 int script_logic_cond(struct script * script, struct script_range * x, struct map * map, range_cb cb) {
     int status = 0;
 
+    char * key;
     struct script_range * y;
     struct script_range * z;
 
-    y = map_search(map, x->string);
+    key = script_range_string(script, x);
+    if(!key)
+        return panic("failed to string range script object");
+
+    y = map_search(map, key);
     if(y) {
         z = script_range_create(script, y->type, "%s", y->string);
         if(!z) {
@@ -728,7 +1770,7 @@ int script_logic_cond(struct script * script, struct script_range * x, struct ma
         } else if(map_insert(map, z->string, z)) {
             status = panic("failed to insert map object");
         }
-    } else if(map_insert(map, x->string, x)) {
+    } else if(map_insert(map, key, x)) {
         status = panic("failed to insert map object");
     }
 
@@ -740,7 +1782,7 @@ int script_logic_not_cond(struct script * script, struct script_range * x, struc
 
     struct script_range * y;
 
-    y = script_range_create(script, x->type, "%s", x->string);
+    y = script_range_join(script, x->type, "%s", x, NULL);
     if(!y) {
         status = panic("failed to create script range object");
     } else if(range_not(y->range, x->range)) {
@@ -752,7 +1794,7 @@ int script_logic_not_cond(struct script * script, struct script_range * x, struc
     return status;
 }
 
-int script_generate(struct script * script, char * string, struct strbuf * strbuf) {
+int script_generate(struct script * script, struct script_node * root, struct strbuf * strbuf) {
     int status = 0;
 
     struct map map;
@@ -763,10 +1805,10 @@ int script_generate(struct script * script, char * string, struct strbuf * strbu
         if(script_map_push(script, &map)) {
             status = panic("failed to map push script object");
         } else {
-            if(script_parse(script, string)) {
-                status = panic("failed to parse script object");
-            } else if(script_translate(script, script->root)) {
+            if(script_translate(script, root)) {
                 status = panic("failed to translate script object");
+            } else if(script->exhausted && script->output == strbuf && strbuf_printf(strbuf, "[remaining effects omitted]\n")) {
+                status = panic("failed to printf strbuf object");
             }
             strbuf_trim(strbuf);
 
@@ -784,55 +1826,337 @@ int script_parse(struct script * script, char * string) {
     size_t length;
     char * source;
 
-    SCRIPTSTYPE value;
-    int token;
-    int state = YYPUSH_MORE;
+    length = strlen(string);
+    source = store_malloc(&script->store, length + 2);
+    if(!source) {
+        status = panic("failed to malloc store object");
+    } else {
+        memcpy(source, string, length);
+        source[length] = 0;
+        source[length + 1] = 0;
+
+        if(script_scan(script, source, length + 2)) {
+            status = panic("failed to scan script object");
+        } else if(script_layout(script)) {
+            status = panic("failed to layout script object");
+        }
+    }
+
+    return status;
+}
+
+int script_parse_buffer(struct script * script, char * string) {
+    /* the string is followed by a second nul */
+    if(script_scan(script, string, strlen(string) + 2))
+        return panic("failed to scan script object");
+
+    if(script_layout(script))
+        return panic("failed to layout script object");
+
+    return 0;
+}
+
+int script_scan(struct script * script, char * buffer, size_t size) {
+    int status = 0;
+
+    SCRIPTSTYPE value;
+    int quiet;
+    int token;
+    int state = YYPUSH_MORE;
+
+    if(!script_scan_buffer(buffer, size, script->scanner)) {
+        status = panic("failed to scan buffer scanner object");
+    } else {
+        while(state == YYPUSH_MORE && !status) {
+            token = scriptlex(&value, script->scanner);
+            if(token < 0) {
+                status = panic("failed to get the next token");
+            } else {
+                state = scriptpush_parse(script->parser, token, &value, script);
+                if(state && state != YYPUSH_MORE)
+                    status = panic("failed to parse the current token");
+            }
+        }
+
+        if(status) {
+            quiet = panic_quiet(1);
+
+            /* the scanner puts back the character it held once it reaches
+             * the end, so every invalid character after the first is read */
+            while(scriptlex(&value, script->scanner));
+
+            /* the end of the input resets a parser left in the middle */
+            if(state == YYPUSH_MORE)
+                scriptpush_parse(script->parser, 0, &value, script);
+
+            panic_quiet(quiet);
+        }
+
+        scriptpop_buffer_state(script->scanner);
+    }
+
+    return status;
+}
+
+int script_layout(struct script * script) {
+    if(script_fold(script, script->tree))
+        return panic("failed to fold script object");
+
+    if(script_flatten(&script->store, script->tree, &script->root))
+        return panic("failed to flatten script object");
+
+    return 0;
+}
+
+int script_flatten(struct store * store, struct script_tree * tree, struct script_node ** result) {
+    size_t count = 0;
+    size_t length = 0;
+    char * text;
+    struct script_node * node;
+
+    /* only the last parsed script is laid out */
+    script_flatten_size(tree, &count, &length);
+    if(count * sizeof(*node) + length > INT_MAX)
+        return panic("script is too large");
+
+    node = store_malloc(store, count * sizeof(*node) + length);
+    if(!node)
+        return panic("failed to malloc store object");
+
+    text = (char *) (node + count);
+    *result = script_flatten_node(tree, &node, &text);
+
+    return 0;
+}
+
+void script_flatten_size(struct script_tree * tree, size_t * count, size_t * length) {
+    struct script_tree * iter;
+
+    *count += 1;
+
+    if(tree->token == script_identifier || tree->token == script_string)
+        *length += strlen(tree->identifier) + 1;
+
+    if(tree->string)
+        *length += strlen(tree->string) + 1;
+
+    iter = tree->root;
+    while(iter) {
+        script_flatten_size(iter, count, length);
+        iter = iter->next;
+    }
+}
+
+struct script_node * script_flatten_node(struct script_tree * tree, struct script_node ** node, char ** text) {
+    struct script_node * copy;
+    struct script_node * last;
+    struct script_node * child;
+    struct script_tree * iter;
+
+    copy = (*node)++;
+    memset(copy, 0, sizeof(*copy));
+    copy->token = tree->token;
+
+    if(tree->token == script_identifier || tree->token == script_string) {
+        copy->identifier = script_flatten_text(copy, tree->identifier, text);
+    } else {
+        copy->integer = tree->integer;
+    }
+
+    if(tree->string)
+        copy->string = script_flatten_text(copy, tree->string, text);
+
+    /* the children follow their parent */
+    last = NULL;
+    iter = tree->root;
+    while(iter) {
+        child = script_flatten_node(iter, node, text);
+        if(last) {
+            last->next = child - last;
+        } else {
+            copy->root = child - copy;
+        }
+        last = child;
+        iter = iter->next;
+    }
+
+    return copy;
+}
+
+int script_flatten_text(struct script_node * node, char * string, char ** text) {
+    int offset;
+    size_t length;
+
+    offset = *text - (char *) node;
+    length = strlen(string) + 1;
+    memcpy(*text, string, length);
+    *text += length;
+
+    return offset;
+}
+
+int script_fold(struct script * script, struct script_tree * root) {
+    while(root) {
+        if(script_fold(script, root->root) || script_fold_node(script, root))
+            return 1;
+        root = root->next;
+    }
+
+    return 0;
+}
+
+int script_fold_node(struct script * script, struct script_tree * root) {
+    long x;
+    long y;
+    long z;
+    double power;
+    struct script_tree * left;
+    struct script_tree * right;
+
+    left = root->root;
+    if(!left)
+        return 0;
+
+    switch(root->token) {
+        case script_plus_unary:
+            if(left->token != script_integer)
+                return 0;
+            return script_fold_integer(script, root, left->integer, "+ %s");
+        case script_minus_unary:
+            if(left->token != script_integer || left->integer == LONG_MIN)
+                return 0;
+            return script_fold_integer(script, root, - left->integer, "- %s");
+        case script_bit_not:
+            if(left->token != script_integer)
+                return 0;
+            return script_fold_integer(script, root, ~ left->integer, "~ %s");
+        case script_identifier:
+            /* function call over two literals */
+            if(left->token != script_comma)
+                return 0;
+            left = left->root;
+            break;
+    }
+
+    right = left->next;
+    if(left->token != script_integer || !right || right->token != script_integer)
+        return 0;
+
+    x = left->integer;
+    y = right->integer;
+
+    /* the literal keeps the text the evaluator would have printed */
+    switch(root->token) {
+        case script_bit_or:
+            return script_fold_integer(script, root, x | y, "%s | %s");
+        case script_bit_xor:
+            return script_fold_integer(script, root, x ^ y, "%s ^ %s");
+        case script_bit_and:
+            return script_fold_integer(script, root, x & y, "%s & %s");
+        case script_bit_left:
+            if(x < 0 || y < 0 || y >= (long) sizeof(long) * 8 || x > (LONG_MAX >> y))
+                return 0;
+            return script_fold_integer(script, root, x << y, "%s << %s");
+        case script_bit_right:
+            if(x < 0 || y < 0 || y >= (long) sizeof(long) * 8)
+                return 0;
+            return script_fold_integer(script, root, x >> y, "%s >> %s");
+        case script_plus:
+            if(__builtin_add_overflow(x, y, &z))
+                return 0;
+            return script_fold_integer(script, root, z, "%s + %s");
+        case script_minus:
+            if(__builtin_sub_overflow(x, y, &z))
+                return 0;
+            return script_fold_integer(script, root, z, "%s - %s");
+        case script_multiply:
+            if(__builtin_mul_overflow(x, y, &z))
+                return 0;
+            return script_fold_integer(script, root, z, "%s * %s");
+        case script_divide:
+            if(!y || y == -1)
+                return 0;
+            return script_fold_integer(script, root, x / y, "%s / %s");
+        case script_remainder:
+            if(!y || y == -1)
+                return 0;
+            return script_fold_integer(script, root, x % y, "%s %% %s");
+        case script_identifier:
+            if(right->next)
+                return 0;
+
+            if(!strcmp(root->identifier, "min")) {
+                return script_fold_integer(script, root, x < y ? x : y, "min(%s,%s)");
+            } else if(!strcmp(root->identifier, "max")) {
+                return script_fold_integer(script, root, x > y ? x : y, "max(%s,%s)");
+            } else if(!strcmp(root->identifier, "pow")) {
+                power = pow(x, y);
+                if(!isfinite(power) || power < LONG_MIN || power >= (double) LONG_MAX)
+                    return 0;
+                return script_fold_integer(script, root, power, "pow(%s,%s)");
+            }
+            break;
+    }
+
+    return 0;
+}
+
+int script_fold_integer(struct script * script, struct script_tree * root, long integer, char * format) {
+    char * x;
+    char * y = NULL;
 
-    length = strlen(string);
-    source = store_malloc(&script->store, length + 2);
-    if(!source) {
-        status = panic("failed to malloc store object");
+    if(root->token == script_identifier) {
+        x = script_fold_string(script, root->root->root);
+        if(x)
+            y = script_fold_string(script, root->root->root->next);
     } else {
-        memcpy(source, string, length);
-        source[length] = 0;
-        source[length + 1] = 0;
-
-        if(!script_scan_buffer(source, length + 2, script->scanner)) {
-            status = panic("failed to scan buffer scanner object");
-        } else {
-            while(state == YYPUSH_MORE && !status) {
-                token = scriptlex(&value, script->scanner);
-                if(token < 0) {
-                    status = panic("failed to get the next token");
-                } else {
-                    state = scriptpush_parse(script->parser, token, &value, script);
-                    if(state && state != YYPUSH_MORE)
-                        status = panic("failed to parse the current token");
-                }
-            }
-            scriptpop_buffer_state(script->scanner);
-        }
+        x = script_fold_string(script, root->root);
+        if(x && root->root->next)
+            y = script_fold_string(script, root->root->next);
     }
 
-    return status;
+    if(!x)
+        return panic("failed to string script node object");
+
+    root->string = store_printf(&script->store, format, x, y);
+    if(!root->string)
+        return panic("failed to printf store object");
+
+    root->token = script_integer;
+    root->integer = integer;
+    root->root = NULL;
+
+    return 0;
+}
+
+char * script_fold_string(struct script * script, struct script_tree * node) {
+    return node->string ? node->string : store_printf(&script->store, "%ld", node->integer);
 }
 
 int script_translate(struct script * script, struct script_node * root) {
     int status = 0;
 
+    long min;
+    long max;
     struct logic logic;
 
     struct script_node * node;
     struct script_range * range;
 
+    if(script_budget(script))
+        return 0;
+
     switch(root->token) {
         case script_curly_open:
-            node = root->root;
+            node = script_node_root(root);
             while(node && !status) {
                 if(script_translate(script, node)) {
                     status = panic("failed to statement script object");
+                } else if(node->token == script_identifier && !strcmp(script_node_identifier(node), "return")) {
+                    /* the statements after a return are not reached */
+                    node = NULL;
                 } else {
-                    node = node->next;
+                    node = script_node_next(node);
                 }
             }
             break;
@@ -840,16 +2164,22 @@ int script_translate(struct script * script, struct script_node * root) {
             /* empty statement */
             break;
         case script_for:
-            /* unsupport loop */
+            if(script_translate_for(script, root))
+                status = panic("failed to translate for script object");
             break;
         case script_if:
             if(script_logic_push(script, &logic)) {
                 status = panic("failed to logic push script object");
             } else {
-                if(script_evaluate(script, root->root, is_logic, &range)) {
+                if(script_evaluate(script, script_node_root(root), is_logic, &range)) {
                     status = panic("failed to expression script object");
-                } else if(script_translate_if(script, root->root->next, "[%s]\n", range->string)) {
-                    status = panic("failed to translate if script object");
+                } else if(!script_range_string(script, range)) {
+                    status = panic("failed to string range script object");
+                } else {
+                    /* skip the block when the condition cannot hold */
+                    range_truth(range->range, &min, &max);
+                    if(max && script_translate_if(script, script_node_next(script_node_root(root)), "[%s]\n", range->string))
+                        status = panic("failed to translate if script object");
                 }
                 script_logic_pop(script);
             }
@@ -862,14 +2192,19 @@ int script_translate(struct script * script, struct script_node * root) {
                     status = panic("failed to logic top push script object");
                 } else if(logic_push(script->logic, or, NULL)) {
                     status = panic("failed to logic top push script object");
-                } else if(script_evaluate(script, root->root, is_logic, &range)) {
+                } else if(script_evaluate(script, script_node_root(root), is_logic, &range)) {
                     status = panic("failed to expression script object");
-                } else if(script_translate_if(script, root->root->next, "[%s]\n", range->string)) {
-                    status = panic("failed to translate if script object");
-                } else if(logic_pop(script->logic)) {
-                    status = panic("failed to logic top pop script object");
-                } else if(script_translate_if(script, root->root->next->next, "[else]\n")) {
-                    status = panic("failed to translate if script object");
+                } else if(!script_range_string(script, range)) {
+                    status = panic("failed to string range script object");
+                } else {
+                    range_truth(range->range, &min, &max);
+                    if(max && script_translate_if(script, script_node_next(script_node_root(root)), "[%s]\n", range->string)) {
+                        status = panic("failed to translate if script object");
+                    } else if(logic_pop(script->logic)) {
+                        status = panic("failed to logic top pop script object");
+                    } else if(!min && script_translate_if(script, script_node_next(script_node_next(script_node_root(root))), "[else]\n")) {
+                        status = panic("failed to translate if script object");
+                    }
                 }
                 script_logic_pop(script);
             }
@@ -878,8 +2213,11 @@ int script_translate(struct script * script, struct script_node * root) {
             if(script_evaluate(script, root, 0, &range)) {
                 status = panic("failed to expression script object");
             } else if(range->type == identifier && root->token == script_identifier) {
-                if(strbuf_printf(script->strbuf, "%s\n", range->string))
+                if(!script_range_string(script, range)) {
+                    status = panic("failed to string range script object");
+                } else if(script_budget_fit(script, strlen(range->string) + 1) && strbuf_printf(script->strbuf, "%s\n", range->string)) {
                     status = panic("failed to printf strbuf object");
+                }
             }
             break;
     }
@@ -892,6 +2230,7 @@ int script_translate_if(struct script * script, struct script_node * root, char
 
     struct map map;
 
+    int length;
     char * string;
     va_list vararg;
     struct strbuf * strbuf;
@@ -922,12 +2261,18 @@ int script_translate_if(struct script * script, struct script_node * root, char
                 status = panic("failed to array strbuf object");
             } else if(*string) {
                 va_start(vararg, format);
-                if(strbuf_vprintf(script->strbuf, format, vararg)) {
-                    status = panic("failed to vprintf strbuf object");
-                } else if(strbuf_printf(script->strbuf, "%s\n", string)) {
-                    status = panic("failed to printf strbuf object");
-                }
+                length = vsnprintf(NULL, 0, format, vararg);
                 va_end(vararg);
+
+                if(script_budget_fit(script, length + strlen(string) + 1)) {
+                    va_start(vararg, format);
+                    if(strbuf_vprintf(script->strbuf, format, vararg)) {
+                        status = panic("failed to vprintf strbuf object");
+                    } else if(strbuf_printf(script->strbuf, "%s\n", string)) {
+                        status = panic("failed to printf strbuf object");
+                    }
+                    va_end(vararg);
+                }
             }
         }
 
@@ -937,9 +2282,214 @@ int script_translate_if(struct script * script, struct script_node * root, char
     return status;
 }
 
+int script_translate_for(struct script * script, struct script_node * root) {
+    int status = 0;
+
+    size_t i;
+    int change;
+    struct map entry;
+    struct map head;
+    struct strbuf * strbuf;
+    struct script_code * code;
+    struct script_range * range;
+
+    /* the step is compiled once and run on every pass */
+    if(script_evaluate(script, script_node_root(root), 0, &range)) {
+        status = panic("failed to evaluate script object");
+    } else if(script_code_compile(&script->store, script_node_next(script_node_next(script_node_root(root))), &code)) {
+        status = panic("failed to compile script object");
+    } else if(map_copy(&entry, script->map)) {
+        status = panic("failed to copy map object");
+    } else {
+        if(map_copy(&head, script->map)) {
+            status = panic("failed to copy map object");
+        } else {
+            strbuf = script_buffer_get(&script->buffer);
+            if(!strbuf) {
+                status = panic("failed to get script buffer object");
+            } else {
+                if(script_strbuf_push(script, strbuf)) {
+                    status = panic("failed to strbuf push script object");
+                } else {
+                    /* repeat the body until the ranges at the head of the loop settle */
+                    change = 1;
+                    for(i = 0; i < SCRIPT_LOOP_MAX && change && !status; i++) {
+                        if(script_loop_load(script, &head)) {
+                            status = panic("failed to loop load script object");
+                        } else if(script_loop_pass(script, root, code)) {
+                            status = panic("failed to loop pass script object");
+                        } else if(script_loop_join(script, &entry, &head, i < SCRIPT_LOOP_WIDEN ? loop_union : loop_widen, &change)) {
+                            status = panic("failed to loop join script object");
+                        }
+                        strbuf_clear(strbuf);
+                    }
+
+                    /* one more pass takes back what the widening gave away */
+                    if(!status && !change) {
+                        if(script_loop_load(script, &head)) {
+                            status = panic("failed to loop load script object");
+                        } else if(script_loop_pass(script, root, code)) {
+                            status = panic("failed to loop pass script object");
+                        } else if(script_loop_join(script, &entry, &head, loop_narrow, &change)) {
+                            status = panic("failed to loop join script object");
+                        }
+                        strbuf_clear(strbuf);
+                    }
+                    script_strbuf_pop(script);
+                }
+                script_buffer_put(&script->buffer, strbuf);
+            }
+
+            /* the body is translated once with the ranges of every iteration */
+            if(!status) {
+                if(script_loop_load(script, &head)) {
+                    status = panic("failed to loop load script object");
+                } else if(script_loop_pass(script, root, code)) {
+                    status = panic("failed to loop pass script object");
+                } else if(script_loop_load(script, &head)) {
+                    status = panic("failed to loop load script object");
+                }
+            }
+            map_destroy(&head);
+        }
+        map_destroy(&entry);
+    }
+
+    return status;
+}
+
+int script_loop_pass(struct script * script, struct script_node * root, struct script_code * code) {
+    int status = 0;
+
+    long min;
+    long max;
+    struct map map;
+    struct logic logic;
+    struct script_node * cond;
+    struct script_range * range;
+
+    cond = script_node_next(script_node_root(root));
+
+    if(script_logic_push(script, &logic)) {
+        status = panic("failed to logic push script object");
+    } else {
+        if(script_evaluate(script, cond, is_logic, &range)) {
+            status = panic("failed to expression script object");
+        } else if(!script_range_string(script, range)) {
+            status = panic("failed to string range script object");
+        } else {
+            range_truth(range->range, &min, &max);
+            if(max) {
+                if(script_translate_if(script, script_node_next(script_node_next(cond)), "[while %s]\n", range->string)) {
+                    status = panic("failed to translate if script object");
+                } else if(script_map_logic_push(script, &map)) {
+                    status = panic("failed to map logic push script object");
+                } else {
+                    if(script_code_run(script, code, 0, &range))
+                        status = panic("failed to run script object");
+                    script_map_logic_pop(script);
+                }
+            }
+        }
+        script_logic_pop(script);
+    }
+
+    return status;
+}
+
+int script_loop_join(struct script * script, struct map * entry, struct map * head, int mode, int * change) {
+    int status = 0;
+
+    long min;
+    long max;
+    struct map_kv kv;
+    struct script_range * x;
+    struct script_range * y;
+    struct script_range * z;
+    struct script_range * range;
+
+    *change = 0;
+
+    kv = map_start(script->map);
+    while(kv.key && !status) {
+        x = kv.value;
+        y = map_search(head, kv.key);
+        z = map_search(entry, kv.key);
+
+        /* a variable that the body does not touch keeps its string */
+        if(x != y) {
+            range = script_range_create(script, identifier, "%s", (char *) kv.key);
+            if(!range) {
+                status = panic("failed to range script object");
+            } else if(!z || !y || !z->range->root || !y->range->root || !x->range->root) {
+                /* unknown on some path */
+            } else if(range_or(range->range, mode == loop_narrow ? z->range : y->range, x->range)) {
+                /* the head already holds the ranges on entry */
+                status = panic("failed to or range object");
+            } else if(mode == loop_widen && !range_same(range->range, y->range)) {
+                /* jump the bound that keeps moving to the end of the integer */
+                min = range->range->min < y->range->min ? INT_MIN : range->range->min;
+                max = range->range->max > y->range->max ? INT_MAX : range->range->max;
+                range = script_range_create(script, identifier, "%s", (char *) kv.key);
+                if(!range) {
+                    status = panic("failed to range script object");
+                } else if(range_add(range->range, min, max)) {
+                    status = panic("failed to add range object");
+                }
+            } else if(mode == loop_narrow) {
+                /* stay inside the head that was widened */
+                z = range;
+                range = script_range_create(script, identifier, "%s", (char *) kv.key);
+                if(!range) {
+                    status = panic("failed to range script object");
+                } else if(range_and(range->range, z->range, y->range)) {
+                    status = panic("failed to and range object");
+                }
+            }
+
+            if(status) {
+                /* skip */
+            } else if(map_insert(head, kv.key, range)) {
+                status = panic("failed to map insert script object");
+            } else if(!y || !range_same(range->range, y->range)) {
+                *change = 1;
+            }
+        }
+
+        kv = map_next(script->map);
+    }
+
+    return status;
+}
+
+int script_loop_load(struct script * script, struct map * map) {
+    int status = 0;
+
+    struct map_kv kv;
+
+    kv = map_start(map);
+    while(kv.key && !status) {
+        if(map_insert(script->map, kv.key, kv.value)) {
+            status = panic("failed to map insert script object");
+        } else {
+            kv = map_next(map);
+        }
+    }
+
+    return status;
+}
+
+char * script_assign_key(struct script * script, struct script_node * root, struct script_range * range) {
+    /* a variable that holds a value is stored under its name */
+    return root->token == script_identifier && !script_node_root(root) ? script_node_identifier(root) : script_range_string(script, range);
+}
+
 int script_evaluate(struct script * script, struct script_node * root, int flag, struct script_range ** result) {
     int status = 0;
 
+    long min;
+    long max;
+    char * key;
     struct logic logic;
     struct stack stack;
 
@@ -954,9 +2504,15 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
     struct argument_node * argument;
     struct constant_node * constant;
 
+    script->step++;
+
     switch(root->token) {
         case script_integer:
-            range = script_range_create(script, integer, "%ld", root->integer);
+            if(script_node_string(root)) {
+                range = script_range_create(script, integer, "%s", script_node_string(root));
+            } else {
+                range = script_range_create(script, integer, "%ld", root->integer);
+            }
             if(!range) {
                 status = panic("failed to range script object");
             } else if(range_add(range->range, root->integer, root->integer)) {
@@ -966,25 +2522,29 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_identifier:
-            if(root->root) {
+            if(script_node_root(root)) {
                 if(script_stack_push(script, &stack)) {
                     status = panic("failed to stack push script object");
                 } else {
-                    if(script_evaluate(script, root->root, flag | is_array, &x)) {
+                    if(script_evaluate(script, script_node_root(root), flag | is_array, &x)) {
                         status = panic("failed to evaluate script object");
                     } else if(!stack_top(script->stack) && stack_push(script->stack, x)) {
                         status = panic("failed to push stack object");
                     } else {
-                        function = map_search(&script->function, root->identifier);
+                        function = map_search(&script->function, script_node_identifier(root));
                         if(function) {
-                            range = function(script, script->stack);
-                            if(!range) {
-                                status = panic("failed to function range script object");
+                            if(script_stack_string(script, script->stack)) {
+                                status = panic("failed to stack string script object");
                             } else {
-                                *result = range;
+                                range = function(script, script->stack);
+                                if(!range) {
+                                    status = panic("failed to function range script object");
+                                } else {
+                                    *result = range;
+                                }
                             }
                         } else {
-                            argument = statement_identifier(script->table, root->identifier);
+                            argument = statement_identifier(script->table, script_node_identifier(root));
                             if(argument) {
                                 range = script_execute(script, script->stack, argument);
                                 if(!range) {
@@ -993,10 +2553,10 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                                     *result = range;
                                 }
                             } else {
-                                if(undefined_add(&script->undefined, "statement.%s", root->identifier)) {
+                                if(undefined_add(&script->undefined, "statement.%s", script_node_identifier(root))) {
                                     status = panic("failed to add undefined object");
                                 } else {
-                                    range = script_range_create(script, identifier, "%s", root->identifier);
+                                    range = script_range_create(script, identifier, "%s", script_node_identifier(root));
                                     if(!range) {
                                         status = panic("failed to range script object");
                                     } else {
@@ -1008,8 +2568,17 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                     }
                     script_stack_pop(script);
                 }
+            } else if(script->depth && !strcmp(script_node_identifier(root), "getargcount")) {
+                range = script_range_create(script, integer, "%zu", script->argument_count);
+                if(!range) {
+                    status = panic("failed to range script object");
+                } else if(range_add(range->range, script->argument_count, script->argument_count)) {
+                    status = panic("failed to add range object");
+                } else {
+                    *result = range;
+                }
             } else {
-                argument = statement_identifier(script->table, root->identifier);
+                argument = statement_identifier(script->table, script_node_identifier(root));
                 if(argument) {
                     range = script_execute(script, NULL, argument);
                     if(!range) {
@@ -1018,7 +2587,7 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                         *result = range;
                     }
                 } else {
-                    constant = constant_identifier(script->table, root->identifier);
+                    constant = constant_identifier(script->table, script_node_identifier(root));
                     if(constant) {
                         range = script_range_create(script, constant->variable ? identifier : integer, "%s", constant->identifier);
                         if(!range) {
@@ -1040,11 +2609,11 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                             *result = range;
                         }
                     } else {
-                        range = map_search(script->map, root->identifier);
+                        range = map_search(script->map, script_node_identifier(root));
                         if(range) {
                             *result = range;
                         } else {
-                            range = script_range_create(script, identifier, "%s", root->identifier);
+                            range = script_range_create(script, identifier, "%s", script_node_identifier(root));
                             if(!range) {
                                 status = panic("failed to range script object");
                             } else {
@@ -1056,7 +2625,7 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                          * use variable identifier when concatenating a with string
                          */
                         if(flag & is_concat) {
-                            range = script_range_create(script, identifier, "%s", root->identifier);
+                            range = script_range_create(script, identifier, "%s", script_node_identifier(root));
                             if(!range) {
                                 status = panic("failed to range script object");
                             } else {
@@ -1068,21 +2637,26 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
 
             if(!status && script->map_logic) {
-                x = map_search(script->map_logic, range->string);
-                if(x) {
-                    y = script_range_create(script, range->type, "%s", range->string);
-                    if(!y) {
-                        status = panic("failed to range script object");
-                    } else if(range_and(y->range, x->range, range->range)) {
-                        status = panic("failed to and range object");
-                    } else {
-                        *result = y;
+                key = script_range_string(script, range);
+                if(!key) {
+                    status = panic("failed to string range script object");
+                } else {
+                    x = map_search(script->map_logic, key);
+                    if(x) {
+                        y = script_range_join(script, range->type, "%s", range, NULL);
+                        if(!y) {
+                            status = panic("failed to range script object");
+                        } else if(range_and(y->range, x->range, range->range)) {
+                            status = panic("failed to and range object");
+                        } else {
+                            *result = y;
+                        }
                     }
                 }
             }
             break;
         case script_string:
-            range = script_range_create(script, string, "%s", root->identifier);
+            range = script_range_create(script, string, "%s", script_node_identifier(root));
             if(!range) {
                 status = panic("failed to range script object");
             } else {
@@ -1090,15 +2664,15 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_comma:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
                 if(flag & is_array) {
-                    if(root->root->token == script_comma) {
+                    if(script_node_root(root)->token == script_comma) {
                         if(stack_push(script->stack, y))
                             status = panic("failed to push stack object");
-                    } else if(root->root->next->token == script_comma) {
+                    } else if(script_node_next(script_node_root(root))->token == script_comma) {
                         if(stack_push(script->stack, x))
                             status = panic("failed to push stack object");
                     } else {
@@ -1108,7 +2682,7 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                 }
 
                 if(!status) {
-                    range = script_range_create(script, integer, "%s", y->string);
+                    range = script_range_join(script, integer, "%s", y, NULL);
                     if(!range) {
                         status = panic("failed to range script object");
                     } else if(range_assign(range->range, y->range)) {
@@ -1120,16 +2694,18 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_assign:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, identifier, "%s", y->string);
+                range = script_range_join(script, identifier, "%s", y, NULL);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_assign(range->range, y->range)) {
                     status = panic("failed to assign range object");
-                } else if(map_insert(script->map, x->string, range)) {
+                } else if(!(key = script_assign_key(script, script_node_root(root), x))) {
+                    status = panic("failed to assign key script object");
+                } else if(map_insert(script->map, key, range)) {
                     status = panic("failed to map insert script object");
                 } else {
                     *result = range;
@@ -1137,16 +2713,18 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_plus_assign:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, identifier, "%s", y->string);
+                range = script_range_join(script, identifier, "%s", y, NULL);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_plus(range->range, x->range, y->range)) {
                     status = panic("failed to plus range object");
-                } else if(map_insert(script->map, x->string, range)) {
+                } else if(!(key = script_assign_key(script, script_node_root(root), x))) {
+                    status = panic("failed to assign key script object");
+                } else if(map_insert(script->map, key, range)) {
                     status = panic("failed to map insert script object");
                 } else {
                     *result = range;
@@ -1154,16 +2732,18 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_minus_assign:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, identifier, "%s", y->string);
+                range = script_range_join(script, identifier, "%s", y, NULL);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_minus(range->range, x->range, y->range)) {
                     status = panic("failed to minus range object");
-                } else if(map_insert(script->map, x->string, range)) {
+                } else if(!(key = script_assign_key(script, script_node_root(root), x))) {
+                    status = panic("failed to assign key script object");
+                } else if(map_insert(script->map, key, range)) {
                     status = panic("failed to map insert script object");
                 } else {
                     *result = range;
@@ -1177,11 +2757,26 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                 if(logic_push(script->logic, not, NULL)) {
                     status = panic("failed to logic top push script object");
                 } else {
-                    if( script_evaluate(script, root->root, flag | is_logic, &x) ||
-                        script_evaluate(script, root->root->next, flag, &y) ) {
+                    if(script_evaluate(script, script_node_root(root), flag | is_logic, &x)) {
+                        status = panic("failed to evaluate script object");
+                    } else {
+                        /* keep the value of the branch that is always taken */
+                        range_truth(x->range, &min, &max);
+                        if(script_node_next(script_node_root(root))->token != script_colon) {
+                            /* skip */
+                        } else if(!max) {
+                            flag |= is_false;
+                        } else if(min) {
+                            flag |= is_true;
+                        }
+                    }
+
+                    if(status) {
+                        /* skip */
+                    } else if(script_evaluate(script, script_node_next(script_node_root(root)), flag, &y)) {
                         status = panic("failed to evaluate script object");
                     } else {
-                        range = script_range_create(script, integer, "%s ? %s", x->string, y->string);
+                        range = script_range_join(script, integer, "%s ? %s", x, y);
                         if(!range) {
                             status = panic("failed to range script object");
                         } else if(range_assign(range->range, y->range)) {
@@ -1195,29 +2790,36 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_colon:
-            if(script_evaluate(script, root->root, flag, &x)) {
+            if(script_evaluate(script, script_node_root(root), flag & ~(is_true | is_false), &x)) {
                 status = panic("failed to evaluate script object");
             } else if(logic_pop(script->logic)) {
                 status = panic("failed to logic top pop script object");
-            } else if(script_evaluate(script, root->root->next, flag, &y)) {
+            } else if(script_evaluate(script, script_node_next(script_node_root(root)), flag & ~(is_true | is_false), &y)) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, integer, "%s : %s", x->string, y->string);
+                range = script_range_join(script, integer, "%s : %s", x, y);
                 if(!range) {
                     status = panic("failed to range script object");
+                } else if(flag & is_true) {
+                    if(range_assign(range->range, x->range))
+                        status = panic("failed to assign range object");
+                } else if(flag & is_false) {
+                    if(range_assign(range->range, y->range))
+                        status = panic("failed to assign range object");
                 } else if(range_or(range->range, x->range, y->range)) {
                     status = panic("failed to or range object");
-                } else {
-                    *result = range;
                 }
+
+                if(!status)
+                    *result = range;
             }
             break;
         case script_bit_or:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, integer, "%s | %s", x->string, y->string);
+                range = script_range_join(script, integer, "%s | %s", x, y);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_bit_or(range->range, x->range, y->range)) {
@@ -1228,11 +2830,11 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_bit_xor:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, integer, "%s ^ %s", x->string, y->string);
+                range = script_range_join(script, integer, "%s ^ %s", x, y);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_bit_xor(range->range, x->range, y->range)) {
@@ -1243,11 +2845,11 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_bit_and:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, integer, "%s & %s", x->string, y->string);
+                range = script_range_join(script, integer, "%s & %s", x, y);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_bit_and(range->range, x->range, y->range)) {
@@ -1258,11 +2860,11 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_bit_left:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, integer, "%s << %s", x->string, y->string);
+                range = script_range_join(script, integer, "%s << %s", x, y);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_bit_left(range->range, x->range, y->range)) {
@@ -1273,11 +2875,11 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_bit_right:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, integer, "%s >> %s", x->string, y->string);
+                range = script_range_join(script, integer, "%s >> %s", x, y);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_bit_right(range->range, x->range, y->range)) {
@@ -1288,15 +2890,15 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_plus:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
                 if(x->type == string) {
-                    if(script_evaluate(script, root->root->next, flag | is_concat, &z)) {
+                    if(script_evaluate(script, script_node_next(script_node_root(root)), flag | is_concat, &z)) {
                         status = panic("failed to evaluate script object");
                     } else {
-                        range = script_range_create(script, integer, "%s%s", x->string, z->string);
+                        range = script_range_join(script, integer, "%s%s", x, z);
                         if(!range) {
                             status = panic("failed to range script object");
                         } else if(range_plus(range->range, x->range, y->range)) {
@@ -1306,10 +2908,10 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                         }
                     }
                 } else if(y->type == string) {
-                    if(script_evaluate(script, root->root, flag | is_concat, &z)) {
+                    if(script_evaluate(script, script_node_root(root), flag | is_concat, &z)) {
                         status = panic("failed to evaluate script object");
                     } else {
-                        range = script_range_create(script, integer, "%s%s", z->string, y->string);
+                        range = script_range_join(script, integer, "%s%s", z, y);
                         if(!range) {
                             status = panic("failed to range script object");
                         } else if(range_plus(range->range, x->range, y->range)) {
@@ -1319,7 +2921,7 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                         }
                     }
                 } else {
-                    range = script_range_create(script, integer, "%s + %s", x->string, y->string);
+                    range = script_range_join(script, integer, "%s + %s", x, y);
                     if(!range) {
                         status = panic("failed to range script object");
                     } else if(range_plus(range->range, x->range, y->range)) {
@@ -1331,11 +2933,11 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_minus:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, integer, "%s - %s", x->string, y->string);
+                range = script_range_join(script, integer, "%s - %s", x, y);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_minus(range->range, x->range, y->range)) {
@@ -1346,11 +2948,11 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_multiply:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, integer, "%s * %s", x->string, y->string);
+                range = script_range_join(script, integer, "%s * %s", x, y);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_multiply(range->range, x->range, y->range)) {
@@ -1361,11 +2963,11 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_divide:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, integer, "%s / %s", x->string, y->string);
+                range = script_range_join(script, integer, "%s / %s", x, y);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_divide(range->range, x->range, y->range)) {
@@ -1376,11 +2978,11 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_remainder:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, integer, "%s %% %s", x->string, y->string);
+                range = script_range_join(script, integer, "%s %% %s", x, y);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_remainder(range->range, x->range, y->range)) {
@@ -1391,10 +2993,10 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_plus_unary:
-            if(script_evaluate(script, root->root, flag, &x)) {
+            if(script_evaluate(script, script_node_root(root), flag, &x)) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, integer, "+ %s", x->string);
+                range = script_range_join(script, integer, "+ %s", x, NULL);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_plus_unary(range->range, x->range)) {
@@ -1405,10 +3007,10 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_minus_unary:
-            if(script_evaluate(script, root->root, flag, &x)) {
+            if(script_evaluate(script, script_node_root(root), flag, &x)) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, integer, "- %s", x->string);
+                range = script_range_join(script, integer, "- %s", x, NULL);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_minus_unary(range->range, x->range)) {
@@ -1419,10 +3021,10 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_bit_not:
-            if(script_evaluate(script, root->root, flag, &x)) {
+            if(script_evaluate(script, script_node_root(root), flag, &x)) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, integer, "~ %s", x->string);
+                range = script_range_join(script, integer, "~ %s", x, NULL);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_bit_not(range->range, x->range)) {
@@ -1434,31 +3036,61 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             break;
         case script_increment_prefix:
         case script_increment_postfix:
-            if(script_evaluate(script, root->root, flag, &x)) {
+            if(script_evaluate(script, script_node_root(root), flag, &x)) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, integer, "%s ++", x->string);
+                range = script_range_join(script, integer, "%s ++", x, NULL);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_increment(range->range, x->range)) {
                     status = panic("failed to increment range object");
                 } else {
                     *result = range;
+
+                    /* the variable keeps the exact value for the next statement */
+                    if(script_node_root(root)->token == script_identifier && !script_node_root(script_node_root(root))) {
+                        y = script_range_create(script, integer, "1");
+                        z = script_range_join(script, identifier, "%s + 1", x, NULL);
+                        if(!y || !z) {
+                            status = panic("failed to range script object");
+                        } else if(range_add(y->range, 1, 1)) {
+                            status = panic("failed to add range object");
+                        } else if(range_plus(z->range, x->range, y->range)) {
+                            status = panic("failed to plus range object");
+                        } else if(map_insert(script->map, script_node_identifier(script_node_root(root)), z)) {
+                            status = panic("failed to map insert script object");
+                        }
+                    }
                 }
             }
             break;
         case script_decrement_prefix:
         case script_decrement_postfix:
-            if(script_evaluate(script, root->root, flag, &x)) {
+            if(script_evaluate(script, script_node_root(root), flag, &x)) {
                 status = panic("failed to evaluate script object");
             } else {
-                range = script_range_create(script, integer, "%s --", x->string);
+                range = script_range_join(script, integer, "%s --", x, NULL);
                 if(!range) {
                     status = panic("failed to range script object");
                 } else if(range_decrement(range->range, x->range)) {
                     status = panic("failed to decrement range object");
                 } else {
                     *result = range;
+
+                    /* the variable keeps the exact value for the next statement */
+                    if(script_node_root(root)->token == script_identifier && !script_node_root(script_node_root(root))) {
+                        y = script_range_create(script, integer, "1");
+                        z = script_range_join(script, identifier, "%s - 1", x, NULL);
+                        if(!y || !z) {
+                            status = panic("failed to range script object");
+                        } else if(range_add(y->range, 1, 1)) {
+                            status = panic("failed to add range object");
+                        } else if(range_minus(z->range, x->range, y->range)) {
+                            status = panic("failed to minus range object");
+                        } else if(map_insert(script->map, script_node_identifier(script_node_root(root)), z)) {
+                            status = panic("failed to map insert script object");
+                        }
+                    }
                 }
             }
             break;
@@ -1467,25 +3099,25 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                 if(logic_push(script->logic, or, NULL)) {
                     status = panic("failed to logic top push script object");
                 } else {
-                    if( script_evaluate(script, root->root, flag, &x) ||
-                        script_evaluate(script, root->root->next, flag, &y) ) {
+                    if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                        script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                         status = panic("failed to evaluate script object");
                     } else if(logic_pop(script->logic)) {
                         status = panic("failed to logic top pop script object");
                     }
                 }
             } else {
-                if( script_evaluate(script, root->root, flag, &x) ||
-                    script_evaluate(script, root->root->next, flag, &y) )
+                if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                    script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) )
                     status = panic("failed to evaluate script object");
             }
 
             if(!status) {
-                range = script_range_create(script, integer, "%s || %s", x->string, y->string);
+                range = script_range_join(script, integer, "%s || %s", x, y);
                 if(!range) {
                     status = panic("failed to range script object");
-                } else if(range_add(range->range, 0, 1)) {
-                    status = panic("failed to add range object");
+                } else if(script_logic_range(root->token, x->range, y->range, range->range)) {
+                    status = panic("failed to logic range script object");
                 } else {
                     *result = range;
                 }
@@ -1496,25 +3128,25 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                 if(logic_push(script->logic, and, NULL)) {
                     status = panic("failed to logic top push script object");
                 } else {
-                    if( script_evaluate(script, root->root, flag, &x) ||
-                        script_evaluate(script, root->root->next, flag, &y) ) {
+                    if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                        script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                         status = panic("failed to evaluate script object");
                     } else if(logic_pop(script->logic)) {
                         status = panic("failed to logic top pop script object");
                     }
                 }
             } else {
-                if( script_evaluate(script, root->root, flag, &x) ||
-                    script_evaluate(script, root->root->next, flag, &y) )
+                if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                    script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) )
                     status = panic("failed to evaluate script object");
             }
 
             if(!status) {
-                range = script_range_create(script, integer, "%s && %s", x->string, y->string);
+                range = script_range_join(script, integer, "%s && %s", x, y);
                 if(!range) {
                     status = panic("failed to range script object");
-                } else if(range_add(range->range, 0, 1)) {
-                    status = panic("failed to add range object");
+                } else if(script_logic_range(root->token, x->range, y->range, range->range)) {
+                    status = panic("failed to logic range script object");
                 } else {
                     *result = range;
                 }
@@ -1524,35 +3156,35 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             if(flag & is_logic) {
                 if(logic_push(script->logic, not, NULL)) {
                     status = panic("failed to logic top push script object");
-                } else if(script_evaluate(script, root->root, flag, &x)) {
+                } else if(script_evaluate(script, script_node_root(root), flag, &x)) {
                     status = panic("failed to evaluate script object");
                 } else if(logic_pop(script->logic)) {
                     status = panic("failed to logic top pop script object");
                 }
             } else {
-                if(script_evaluate(script, root->root, flag, &x))
+                if(script_evaluate(script, script_node_root(root), flag, &x))
                     status = panic("failed to evaluate script object");
             }
 
             if(!status) {
-                range = script_range_create(script, integer, "! %s", x->string);
+                range = script_range_join(script, integer, "! %s", x, NULL);
                 if(!range) {
                     status = panic("failed to range script object");
-                } else if(range_add(range->range, 0, 1)) {
-                    status = panic("failed to add range object");
+                } else if(script_logic_range(root->token, x->range, NULL, range->range)) {
+                    status = panic("failed to logic range script object");
                 } else {
                     *result = range;
                 }
             }
             break;
         case script_equal:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
                 if(flag & is_logic) {
                     if(x->type == identifier) {
-                        range = script_range_create(script, identifier, "%s", x->string);
+                        range = script_range_join(script, identifier, "%s", x, NULL);
                         if(!range) {
                             status = panic("failed to range script object");
                         } else if(range_equal(range->range, x->range, y->range)) {
@@ -1563,7 +3195,7 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                     }
 
                     if(y->type == identifier && !status) {
-                        range = script_range_create(script, identifier, "%s", y->string);
+                        range = script_range_join(script, identifier, "%s", y, NULL);
                         if(!range) {
                             status = panic("failed to range script object");
                         } else if(range_equal(range->range, y->range, x->range)) {
@@ -1575,11 +3207,11 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                 }
 
                 if(!status) {
-                    range = script_range_create(script, integer, "%s == %s", x->string, y->string);
+                    range = script_range_join(script, integer, "%s == %s", x, y);
                     if(!range) {
                         status = panic("failed to range script object");
-                    } else if(range_add(range->range, 0, 1)) {
-                        status = panic("failed to add range object");
+                    } else if(script_logic_range(root->token, x->range, y->range, range->range)) {
+                        status = panic("failed to logic range script object");
                     } else {
                         *result = range;
                     }
@@ -1587,13 +3219,13 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_not_equal:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
                 if(flag & is_logic) {
                     if(x->type == identifier) {
-                        range = script_range_create(script, identifier, "%s", x->string);
+                        range = script_range_join(script, identifier, "%s", x, NULL);
                         if(!range) {
                             status = panic("failed to range script object");
                         } else if(range_not_equal(range->range, x->range, y->range)) {
@@ -1604,7 +3236,7 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                     }
 
                     if(y->type == identifier && !status) {
-                        range = script_range_create(script, identifier, "%s", y->string);
+                        range = script_range_join(script, identifier, "%s", y, NULL);
                         if(!range) {
                             status = panic("failed to range script object");
                         } else if(range_not_equal(range->range, y->range, x->range)) {
@@ -1616,11 +3248,11 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                 }
 
                 if(!status) {
-                    range = script_range_create(script, integer, "%s != %s", x->string, y->string);
+                    range = script_range_join(script, integer, "%s != %s", x, y);
                     if(!range) {
                         status = panic("failed to range script object");
-                    } else if(range_add(range->range, 0, 1)) {
-                        status = panic("failed to add range object");
+                    } else if(script_logic_range(root->token, x->range, y->range, range->range)) {
+                        status = panic("failed to logic range script object");
                     } else {
                         *result = range;
                     }
@@ -1628,13 +3260,13 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_lesser:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
                 if(flag & is_logic) {
                     if(x->type == identifier) {
-                        range = script_range_create(script, identifier, "%s", x->string);
+                        range = script_range_join(script, identifier, "%s", x, NULL);
                         if(!range) {
                             status = panic("failed to range script object");
                         } else if(range_lesser(range->range, x->range, y->range)) {
@@ -1645,7 +3277,7 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                     }
 
                     if(y->type == identifier && !status) {
-                        range = script_range_create(script, identifier, "%s", y->string);
+                        range = script_range_join(script, identifier, "%s", y, NULL);
                         if(!range) {
                             status = panic("failed to range script object");
                         } else if(range_greater(range->range, y->range, x->range)) {
@@ -1657,11 +3289,11 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                 }
 
                 if(!status) {
-                    range = script_range_create(script, integer, "%s < %s", x->string, y->string);
+                    range = script_range_join(script, integer, "%s < %s", x, y);
                     if(!range) {
                         status = panic("failed to range script object");
-                    } else if(range_add(range->range, 0, 1)) {
-                        status = panic("failed to add range object");
+                    } else if(script_logic_range(root->token, x->range, y->range, range->range)) {
+                        status = panic("failed to logic range script object");
                     } else {
                         *result = range;
                     }
@@ -1669,13 +3301,13 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_lesser_equal:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
                 if(flag & is_logic) {
                     if(x->type == identifier) {
-                        range = script_range_create(script, identifier, "%s", x->string);
+                        range = script_range_join(script, identifier, "%s", x, NULL);
                         if(!range) {
                             status = panic("failed to range script object");
                         } else if(range_lesser_equal(range->range, x->range, y->range)) {
@@ -1686,7 +3318,7 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                     }
 
                     if(y->type == identifier && !status) {
-                        range = script_range_create(script, identifier, "%s", y->string);
+                        range = script_range_join(script, identifier, "%s", y, NULL);
                         if(!range) {
                             status = panic("failed to range script object");
                         } else if(range_greater_equal(range->range, y->range, x->range)) {
@@ -1698,11 +3330,11 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                 }
 
                 if(!status) {
-                    range = script_range_create(script, integer, "%s <= %s", x->string, y->string);
+                    range = script_range_join(script, integer, "%s <= %s", x, y);
                     if(!range) {
                         status = panic("failed to range script object");
-                    } else if(range_add(range->range, 0, 1)) {
-                        status = panic("failed to add range object");
+                    } else if(script_logic_range(root->token, x->range, y->range, range->range)) {
+                        status = panic("failed to logic range script object");
                     } else {
                         *result = range;
                     }
@@ -1710,13 +3342,13 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_greater:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
                 if(flag & is_logic) {
                     if(x->type == identifier) {
-                        range = script_range_create(script, identifier, "%s", x->string);
+                        range = script_range_join(script, identifier, "%s", x, NULL);
                         if(!range) {
                             status = panic("failed to range script object");
                         } else if(range_greater(range->range, x->range, y->range)) {
@@ -1727,7 +3359,7 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                     }
 
                     if(y->type == identifier && !status) {
-                        range = script_range_create(script, identifier, "%s", y->string);
+                        range = script_range_join(script, identifier, "%s", y, NULL);
                         if(!range) {
                             status = panic("failed to range script object");
                         } else if(range_lesser(range->range, y->range, x->range)) {
@@ -1739,11 +3371,11 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                 }
 
                 if(!status) {
-                    range = script_range_create(script, integer, "%s > %s", x->string, y->string);
+                    range = script_range_join(script, integer, "%s > %s", x, y);
                     if(!range) {
                         status = panic("failed to range script object");
-                    } else if(range_add(range->range, 0, 1)) {
-                        status = panic("failed to add range object");
+                    } else if(script_logic_range(root->token, x->range, y->range, range->range)) {
+                        status = panic("failed to logic range script object");
                     } else {
                         *result = range;
                     }
@@ -1751,13 +3383,13 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
             }
             break;
         case script_greater_equal:
-            if( script_evaluate(script, root->root, flag, &x) ||
-                script_evaluate(script, root->root->next, flag, &y) ) {
+            if( script_evaluate(script, script_node_root(root), flag, &x) ||
+                script_evaluate(script, script_node_next(script_node_root(root)), flag, &y) ) {
                 status = panic("failed to evaluate script object");
             } else {
                 if(flag & is_logic) {
                     if(x->type == identifier) {
-                        range = script_range_create(script, identifier, "%s", x->string);
+                        range = script_range_join(script, identifier, "%s", x, NULL);
                         if(!range) {
                             status = panic("failed to range script object");
                         } else if(range_greater_equal(range->range, x->range, y->range)) {
@@ -1768,7 +3400,7 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                     }
 
                     if(y->type == identifier && !status) {
-                        range = script_range_create(script, identifier, "%s", y->string);
+                        range = script_range_join(script, identifier, "%s", y, NULL);
                         if(!range) {
                             status = panic("failed to range script object");
                         } else if(range_lesser_equal(range->range, y->range, x->range)) {
@@ -1779,23 +3411,374 @@ int script_evaluate(struct script * script, struct script_node * root, int flag,
                     }
                 }
 
-                if(!status) {
-                    range = script_range_create(script, integer, "%s >= %s", x->string, y->string);
-                    if(!range) {
-                        status = panic("failed to range script object");
-                    } else if(range_add(range->range, 0, 1)) {
-                        status = panic("failed to add range object");
-                    } else {
-                        *result = range;
-                    }
-                }
-            }
-            break;
-        default:
-            status = panic("invalid token - %d", root->token);
-            break;
+                if(!status) {
+                    range = script_range_join(script, integer, "%s >= %s", x, y);
+                    if(!range) {
+                        status = panic("failed to range script object");
+                    } else if(script_logic_range(root->token, x->range, y->range, range->range)) {
+                        status = panic("failed to logic range script object");
+                    } else {
+                        *result = range;
+                    }
+                }
+            }
+            break;
+        default:
+            status = panic("invalid token - %d", root->token);
+            break;
+    }
+
+    return status;
+}
+
+int script_code_compile(struct store * store, struct script_node * root, struct script_code ** result) {
+    size_t count;
+    struct script_code * code;
+
+    count = script_code_size(root, 0) + 1;
+
+    code = store_malloc(store, count * sizeof(*code));
+    if(!code)
+        return panic("failed to malloc store object");
+
+    *result = code;
+
+    code = script_code_emit(root, 0, code);
+    code->opcode = code_return;
+    code->target = 0;
+    code->left = 0;
+    code->right = 0;
+    code->node = NULL;
+
+    return 0;
+}
+
+int script_code_opcode(struct script_node * root, int target) {
+    int opcode;
+
+    switch(root->token) {
+        case script_integer: return code_integer;
+        case script_string: return code_string;
+        case script_plus: opcode = code_plus; break;
+        case script_minus: opcode = code_minus; break;
+        case script_multiply: opcode = code_multiply; break;
+        case script_divide: opcode = code_divide; break;
+        case script_remainder: opcode = code_remainder; break;
+        case script_bit_or: opcode = code_bit_or; break;
+        case script_bit_xor: opcode = code_bit_xor; break;
+        case script_bit_and: opcode = code_bit_and; break;
+        case script_bit_left: opcode = code_bit_left; break;
+        case script_bit_right: opcode = code_bit_right; break;
+        case script_plus_unary: opcode = code_plus_unary; break;
+        case script_minus_unary: opcode = code_minus_unary; break;
+        case script_bit_not: opcode = code_bit_not; break;
+        case script_assign: opcode = code_assign; break;
+        case script_plus_assign: opcode = code_plus_assign; break;
+        case script_minus_assign: opcode = code_minus_assign; break;
+        default: return code_evaluate;
+    }
+
+    /* an operator whose operands would run out of registers is walked */
+    return target + script_code_arity(opcode) > SCRIPT_CODE_REGISTER ? code_evaluate : opcode;
+}
+
+int script_code_arity(int opcode) {
+    switch(opcode) {
+        case code_plus_unary:
+        case code_minus_unary:
+        case code_bit_not:
+            return 1;
+        case code_plus:
+        case code_minus:
+        case code_multiply:
+        case code_divide:
+        case code_remainder:
+        case code_bit_or:
+        case code_bit_xor:
+        case code_bit_and:
+        case code_bit_left:
+        case code_bit_right:
+        case code_assign:
+        case code_plus_assign:
+        case code_minus_assign:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+size_t script_code_size(struct script_node * root, int target) {
+    switch(script_code_arity(script_code_opcode(root, target))) {
+        case 2:
+            return script_code_size(script_node_root(root), target) + script_code_size(script_node_next(script_node_root(root)), target + 1) + 1;
+        case 1:
+            return script_code_size(script_node_root(root), target) + 1;
+        default:
+            return 1;
+    }
+}
+
+struct script_code * script_code_emit(struct script_node * root, int target, struct script_code * code) {
+    int opcode;
+
+    /* the operands are emitted before the operator in the order they are evaluated */
+    opcode = script_code_opcode(root, target);
+    switch(script_code_arity(opcode)) {
+        case 2:
+            code = script_code_emit(script_node_root(root), target, code);
+            code = script_code_emit(script_node_next(script_node_root(root)), target + 1, code);
+            code->right = target + 1;
+            break;
+        case 1:
+            code = script_code_emit(script_node_root(root), target, code);
+            code->right = target;
+            break;
+        default:
+            code->right = target;
+            break;
+    }
+
+    code->opcode = opcode;
+    code->target = target;
+    code->left = target;
+    code->node = root;
+
+    return code + 1;
+}
+
+int script_code_run(struct script * script, struct script_code * code, int flag, struct script_range ** result) {
+    int status = 0;
+
+    char * key;
+    char * format;
+    struct script_node * node;
+    struct script_range * x;
+    struct script_range * y;
+    struct script_range * z;
+    struct script_range * range;
+    struct script_range * registers[SCRIPT_CODE_REGISTER];
+    int (* unary) (struct range *, struct range *);
+    int (* binary) (struct range *, struct range *, struct range *);
+
+    /* indexed by enum script_opcode */
+    static void * dispatch[] = {
+        &&run_return,
+        &&run_evaluate,
+        &&run_integer,
+        &&run_string,
+        &&run_plus,
+        &&run_minus,
+        &&run_multiply,
+        &&run_divide,
+        &&run_remainder,
+        &&run_bit_or,
+        &&run_bit_xor,
+        &&run_bit_and,
+        &&run_bit_left,
+        &&run_bit_right,
+        &&run_plus_unary,
+        &&run_minus_unary,
+        &&run_bit_not,
+        &&run_assign,
+        &&run_plus_assign,
+        &&run_minus_assign
+    };
+
+    goto *dispatch[code->opcode];
+
+run_evaluate:
+    if(script_evaluate(script, code->node, flag, &registers[code->target])) {
+        status = panic("failed to evaluate script object");
+        goto done;
+    }
+    goto *dispatch[(++code)->opcode];
+
+run_integer:
+    script->step++;
+    node = code->node;
+    if(script_node_string(node)) {
+        range = script_range_create(script, integer, "%s", script_node_string(node));
+    } else {
+        range = script_range_create(script, integer, "%ld", node->integer);
+    }
+    if(!range) {
+        status = panic("failed to range script object");
+        goto done;
+    } else if(range_add(range->range, node->integer, node->integer)) {
+        status = panic("failed to add range object");
+        goto done;
+    }
+    registers[code->target] = range;
+    goto *dispatch[(++code)->opcode];
+
+run_string:
+    script->step++;
+    range = script_range_create(script, string, "%s", script_node_identifier(code->node));
+    if(!range) {
+        status = panic("failed to range script object");
+        goto done;
     }
+    registers[code->target] = range;
+    goto *dispatch[(++code)->opcode];
+
+run_plus:
+    x = registers[code->left];
+    y = registers[code->right];
+    if(x->type == string) {
+        script->step++;
+        if(script_evaluate(script, script_node_next(script_node_root(code->node)), flag | is_concat, &z)) {
+            status = panic("failed to evaluate script object");
+            goto done;
+        }
+        range = script_range_join(script, integer, "%s%s", x, z);
+    } else if(y->type == string) {
+        script->step++;
+        if(script_evaluate(script, script_node_root(code->node), flag | is_concat, &z)) {
+            status = panic("failed to evaluate script object");
+            goto done;
+        }
+        range = script_range_join(script, integer, "%s%s", z, y);
+    } else {
+        format = "%s + %s";
+        binary = range_plus;
+        goto run_binary;
+    }
+    if(!range) {
+        status = panic("failed to range script object");
+        goto done;
+    } else if(range_plus(range->range, x->range, y->range)) {
+        status = panic("failed to plus range object");
+        goto done;
+    }
+    registers[code->target] = range;
+    goto *dispatch[(++code)->opcode];
+
+run_minus:
+    format = "%s - %s";
+    binary = range_minus;
+    goto run_binary;
+
+run_multiply:
+    format = "%s * %s";
+    binary = range_multiply;
+    goto run_binary;
+
+run_divide:
+    format = "%s / %s";
+    binary = range_divide;
+    goto run_binary;
+
+run_remainder:
+    format = "%s %% %s";
+    binary = range_remainder;
+    goto run_binary;
+
+run_bit_or:
+    format = "%s | %s";
+    binary = range_bit_or;
+    goto run_binary;
+
+run_bit_xor:
+    format = "%s ^ %s";
+    binary = range_bit_xor;
+    goto run_binary;
+
+run_bit_and:
+    format = "%s & %s";
+    binary = range_bit_and;
+    goto run_binary;
+
+run_bit_left:
+    format = "%s << %s";
+    binary = range_bit_left;
+    goto run_binary;
+
+run_bit_right:
+    format = "%s >> %s";
+    binary = range_bit_right;
+    goto run_binary;
+
+run_binary:
+    script->step++;
+    x = registers[code->left];
+    y = registers[code->right];
+    range = script_range_join(script, integer, format, x, y);
+    if(!range) {
+        status = panic("failed to range script object");
+        goto done;
+    } else if(binary(range->range, x->range, y->range)) {
+        status = panic("failed to operate range object");
+        goto done;
+    }
+    registers[code->target] = range;
+    goto *dispatch[(++code)->opcode];
+
+run_plus_unary:
+    format = "+ %s";
+    unary = range_plus_unary;
+    goto run_unary;
+
+run_minus_unary:
+    format = "- %s";
+    unary = range_minus_unary;
+    goto run_unary;
+
+run_bit_not:
+    format = "~ %s";
+    unary = range_bit_not;
+    goto run_unary;
+
+run_unary:
+    script->step++;
+    x = registers[code->left];
+    range = script_range_join(script, integer, format, x, NULL);
+    if(!range) {
+        status = panic("failed to range script object");
+        goto done;
+    } else if(unary(range->range, x->range)) {
+        status = panic("failed to operate range object");
+        goto done;
+    }
+    registers[code->target] = range;
+    goto *dispatch[(++code)->opcode];
+
+run_assign:
+    binary = NULL;
+    goto run_store;
+
+run_plus_assign:
+    binary = range_plus;
+    goto run_store;
+
+run_minus_assign:
+    binary = range_minus;
+    goto run_store;
+
+run_store:
+    script->step++;
+    x = registers[code->left];
+    y = registers[code->right];
+    range = script_range_join(script, identifier, "%s", y, NULL);
+    if(!range) {
+        status = panic("failed to range script object");
+        goto done;
+    } else if(binary ? binary(range->range, x->range, y->range) : range_assign(range->range, y->range)) {
+        status = panic("failed to assign range object");
+        goto done;
+    } else if(!(key = script_assign_key(script, script_node_root(code->node), x))) {
+        status = panic("failed to assign key script object");
+        goto done;
+    } else if(map_insert(script->map, key, range)) {
+        status = panic("failed to map insert script object");
+        goto done;
+    }
+    registers[code->target] = range;
+    goto *dispatch[(++code)->opcode];
 
+run_return:
+    *result = registers[code->left];
+
+done:
     return status;
 }
 
@@ -1807,7 +3790,7 @@ struct script_range * script_execute(struct script * script, struct stack * stac
     struct script_range * range;
     struct range_node * node;
 
-    handler = argument->handler ? map_search(&script->argument, argument->handler) : (void *) argument_print;
+    handler = argument->callback;
     if(!handler) {
         status = panic("invalid argument - %s", argument->handler);
     } else {
@@ -1817,6 +3800,8 @@ struct script_range * script_execute(struct script * script, struct stack * stac
         } else {
             if(script_optional(script, stack, argument)) {
                 status = panic("failed to optional script object");
+            } else if(stack && script_stack_string(script, stack)) {
+                status = panic("failed to stack string script object");
             } else if(handler(script, stack, argument, strbuf)) {
                 status = panic("failed to execute argument object");
             } else {
@@ -1853,10 +3838,8 @@ int script_optional(struct script * script, struct stack * stack, struct argumen
     optional = argument->optional;
     while(optional) {
         if(!stack_get(stack, optional->index)) {
-            if(script_parse(script, optional->string)) {
-                return panic("failed to parse script object");
-            } else if(script_evaluate(script, script->root->root, 0, &range)) {
-                return panic("failed to evaluate script object");
+            if(script_code_run(script, optional->code, 0, &range)) {
+                return panic("failed to run script object");
             } else if(stack_push(stack, range)) {
                 return panic("failed to push stack object");
             }
@@ -1881,7 +3864,7 @@ struct script_range * function_set(struct script * script, struct stack * stack)
         if(!y) {
             status = panic("invalid expression");
         } else {
-            range = script_range_create(script, identifier, "%s", y->string);
+            range = script_range_join(script, identifier, "%s", y, NULL);
             if(!range) {
                 status = panic("failed to range script object");
             } else if(range_assign(range->range, y->range)) {
@@ -1909,7 +3892,7 @@ struct script_range * function_min(struct script * script, struct stack * stack)
         if(!y) {
             status = panic("invalid max");
         } else {
-            range = script_range_create(script, integer, "min(%s,%s)", x->string, y->string);
+            range = script_range_join(script, integer, "min(%s,%s)", x, y);
             if(!range) {
                 status = panic("failed to range script object");
             } else if(range_min(range->range, x->range, y->range)) {
@@ -1935,7 +3918,7 @@ struct script_range * function_max(struct script * script, struct stack * stack)
         if(!y) {
             status = panic("invalid max");
         } else {
-            range = script_range_create(script, integer, "max(%s,%s)", x->string, y->string);
+            range = script_range_join(script, integer, "max(%s,%s)", x, y);
             if(!range) {
                 status = panic("failed to range script object");
             } else if(range_max(range->range, x->range, y->range)) {
@@ -1961,7 +3944,7 @@ struct script_range * function_pow(struct script * script, struct stack * stack)
         if(!y) {
             status = panic("invalid power");
         } else {
-            range = script_range_create(script, integer, "pow(%s,%s)", x->string, y->string);
+            range = script_range_join(script, integer, "pow(%s,%s)", x, y);
             if(!range) {
                 status = panic("failed to range script object");
             } else if(range_pow(range->range, x->range, y->range)) {
@@ -1985,14 +3968,14 @@ struct script_range * function_rand(struct script * script, struct stack * stack
     } else {
         y = stack_get(stack, 1);
         if(!y) {
-            range = script_range_create(script, integer, "rand(%s)", x->string);
+            range = script_range_join(script, integer, "rand(%s)", x, NULL);
             if(!range) {
                 status = panic("failed to range script object");
             } else if(range_add(range->range, 0, x->range->max - 1)) {
                 status = panic("failed to add range object");
             }
         } else {
-            range = script_range_create(script, integer, "rand(%s,%s)", x->string, y->string);
+            range = script_range_join(script, integer, "rand(%s,%s)", x, y);
             if(!range) {
                 status = panic("failed to range script object");
             } else if(range_add(range->range, x->range->min, y->range->max)) {
@@ -2159,6 +4142,95 @@ struct script_range * function_getskilllv(struct script * script, struct stack *
     return status ? NULL : range;
 }
 
+struct script_range * function_callfunc(struct script * script, struct stack * stack) {
+    int status = 0;
+    struct script_range * x;
+    struct script_range * range;
+    struct callfunc_node * callfunc;
+    struct script_summary * summary;
+
+    x = stack_get(stack, 0);
+    if(!x) {
+        status = panic("invalid function");
+    } else {
+        range = NULL;
+
+        callfunc = callfunc_identifier(script->table, x->string);
+        if(!callfunc || script->depth + 1 >= SCRIPT_CALL_MAX) {
+            /* the function cannot be seen from here */
+        } else if(script_summary_get(script, callfunc, stack, &summary)) {
+            status = panic("failed to summary get script object");
+        } else if(script_summary_load(script, summary, &range)) {
+            status = panic("failed to summary load script object");
+        }
+
+        if(!status && !range) {
+            range = script_range_join(script, integer, "%s", x, NULL);
+            if(!range)
+                status = panic("failed to range script object");
+        }
+    }
+
+    return status ? NULL : range;
+}
+
+struct script_range * function_getarg(struct script * script, struct stack * stack) {
+    int status = 0;
+    size_t i;
+    struct script_range * x;
+    struct script_range * y;
+    struct script_range * range = NULL;
+
+    x = stack_get(stack, 0);
+    if(!x) {
+        status = panic("invalid index");
+    } else {
+        y = stack_get(stack, 1);
+
+        /* every argument that the index can reach */
+        for(i = 0; i < script->argument_count && !status; i++)
+            if(!x->range->root || range_member(x->range, i))
+                if(script_range_merge(script, &range, script->argument[i]))
+                    status = panic("failed to merge range script object");
+
+        /* and the default past the last argument */
+        if(!status && y && (!x->range->root || x->range->max >= (long) script->argument_count))
+            if(script_range_merge(script, &range, y))
+                status = panic("failed to merge range script object");
+
+        if(!status && !range) {
+            range = script_range_join(script, identifier, "getarg(%s)", x, NULL);
+            if(!range)
+                status = panic("failed to range script object");
+        }
+    }
+
+    return status ? NULL : range;
+}
+
+struct script_range * function_return(struct script * script, struct stack * stack) {
+    int status = 0;
+    struct script_range * x;
+    struct script_range * range;
+
+    x = stack_get(stack, 0);
+    if(!x) {
+        status = panic("invalid return");
+    } else {
+        /* a returned variable is a value and not a statement to print */
+        range = script_range_join(script, x->type == string ? string : integer, "%s", x, NULL);
+        if(!range) {
+            status = panic("failed to range script object");
+        } else if(range_assign(range->range, x->range)) {
+            status = panic("failed to assign range object");
+        } else if(script->depth && script_range_merge(script, &script->result, range)) {
+            status = panic("failed to merge range script object");
+        }
+    }
+
+    return status ? NULL : range;
+}
+
 struct script_range * function_constant(struct script * script, struct stack * stack) {
     int status = 0;
     struct script_range * range;
@@ -2175,7 +4247,7 @@ struct script_range * function_constant(struct script * script, struct stack * s
         } else if(!constant->tag) {
             status = panic("invalid constant tag - %s", range->string);
         } else {
-            range = script_range_create(script, constant->variable ? identifier : integer, "%s", constant->tag);
+            range = script_range_create(script, constant->variable ? identifier : integer, "%s", locale_tag(script->table, constant));
             if(!range) {
                 status = panic("failed to create script range object");
             } else {
@@ -2228,12 +4300,12 @@ int entry_node_call(struct entry_node * entry, struct script * script, struct st
     struct argument_node * argument;
     struct script_range * range;
 
-    handler = map_search(&script->argument, entry->identifier);
+    handler = entry->callback;
     if(handler) {
         if(handler(script, stack, NULL, strbuf))
             return panic("failed to execute argument object");
     } else {
-        argument = argument_identifier(script->table, entry->identifier);
+        argument = entry->argument;
         if(argument) {
             range = script_execute(script, stack, argument);
             if(!range) {
@@ -2249,6 +4321,73 @@ int entry_node_call(struct entry_node * entry, struct script * script, struct st
     return 0;
 }
 
+struct entry_node * render_entry_at(struct argument_node * argument, size_t print, size_t entry) {
+    struct print_node * node;
+    struct entry_node * result;
+
+    node = argument->print;
+    while(node && print--)
+        node = node->next;
+
+    result = node ? node->entry : NULL;
+    while(result && entry--)
+        result = result->next;
+
+    return result;
+}
+
+int render_load(struct stack * result, struct stack * source, size_t count, ...) {
+    int status = 0;
+    size_t i;
+    va_list index;
+    struct script_range * range;
+
+    /* the subset is cleared before each entry instead of after it */
+    stack_clear(result);
+
+    if(!count) {
+        range = stack_start(source);
+        while(range && !status) {
+            if(stack_push(result, range)) {
+                status = panic("failed to push stack object");
+            } else {
+                range = stack_next(source);
+            }
+        }
+    } else {
+        va_start(index, count);
+        for(i = 0; i < count && !status; i++) {
+            range = stack_get(source, va_arg(index, long));
+            if(!range) {
+                status = panic("failed to get stack object");
+            } else if(stack_push(result, range)) {
+                status = panic("failed to push stack object");
+            }
+        }
+        va_end(index);
+    }
+
+    return status;
+}
+
+int render_integer(struct script * script, struct stack * stack, long flag, long divide, struct strbuf * strbuf) {
+    struct script_range * range;
+
+    /* an integer argument without default values is written in place */
+    if(script_stack_string(script, stack)) {
+        return panic("failed to stack string script object");
+    } else {
+        range = stack_get(stack, 0);
+        if(!range) {
+            return panic("failed to get stack object");
+        } else if(argument_integer_write(strbuf, range, flag, divide)) {
+            return panic("failed to execute argument object");
+        }
+    }
+
+    return 0;
+}
+
 int print_node_write(struct print_node * print, struct script * script, struct stack * stack, struct strbuf * strbuf) {
     int status = 0;
     struct stack subset;
@@ -2259,7 +4398,7 @@ int print_node_write(struct print_node * print, struct script * script, struct s
     } else {
         entry = print->entry;
         while(entry && !status) {
-            if(strbuf_strcpy(strbuf, entry->string, entry->length)) {
+            if(!script->check && strbuf_strcpy(strbuf, entry->string, entry->length)) {
                 status = panic("failed to strcpy strbuf object");
             } else if(entry->identifier) {
                 if(entry_node_load(entry, &subset, stack)) {
@@ -2334,97 +4473,123 @@ int argument_zero(struct script * script, struct stack * stack, struct argument_
 }
 
 int argument_array(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
-    long i;
+    char * start;
+    size_t count = 0;
     struct script_range * range;
-    struct range_node * node;
-    char * string = NULL;
+
+    start = strbuf->pos;
 
     range = stack_start(stack);
     while(range) {
-        node = range->range->root;
-        while(node) {
-            for(i = node->min; i <= node->max; i++) {
-                string = map_search(argument->map, &i);
-                if(!string) {
-                    return panic("invalid index - %ld", i);
-                } else if(strbuf_printf(strbuf, "%s, ", string)) {
-                    return panic("failed to printf strbuf object");
-                }
-            }
-            node = node->next;
-        }
+        if(script_range_name(script, range, strbuf, start, "values", argument_array_name, argument->map, &count))
+            return panic("failed to name range script object");
         range = stack_next(stack);
     }
 
-    if(string && strbuf_unputn(strbuf, 2))
+    if(count && strbuf_unputn(strbuf, 2))
         return panic("failed to unputn strbuf object");
 
     return 0;
 }
 
-int argument_integer(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
-    long min;
-    long max;
-    long tmp;
+char * argument_array_name(struct script * script, void * context, long i) {
+    char * string;
 
-    long flag;
-    long divide;
+    string = map_search(context, &i);
+    if(!string)
+        panic("invalid index - %ld", i);
+
+    return string;
+}
 
+int argument_integer(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
     struct script_range * range;
 
     range = stack_get(stack, 0);
     if(!range) {
         return panic("failed to get stack object");
-    } else {
-        if(argument->integer) {
-            flag = argument->integer->flag;
-            divide = argument->integer->divide;
-        } else {
-            flag = 0;
-            divide = 0;
-        }
-
-        min = range->range->min;
-        max = range->range->max;
+    } else if(argument->integer) {
+        if(argument_integer_write(strbuf, range, argument->integer->flag, argument->integer->divide))
+            return panic("failed to write integer argument object");
+    } else if(argument_integer_write(strbuf, range, 0, 0)) {
+        return panic("failed to write integer argument object");
+    }
 
-        if(flag & integer_absolute) {
-            if(min < 0)
-                min *= -1;
+    return 0;
+}
 
-            if(max < 0)
-                max *= -1;
+int argument_integer_write(struct strbuf * strbuf, struct script_range * range, long flag, long divide) {
+    long min;
+    long max;
+    long tmp;
 
-            if(min > max) {
-                tmp = min;
-                min = max;
-                max = tmp;
-            }
-        }
+    min = range->range->min;
+    max = range->range->max;
 
-        if(flag & integer_inverse) {
+    if(flag & integer_absolute) {
+        if(min < 0)
             min *= -1;
+
+        if(max < 0)
             max *= -1;
 
+        if(min > max) {
             tmp = min;
             min = max;
             max = tmp;
         }
+    }
+
+    if(flag & integer_inverse) {
+        min *= -1;
+        max *= -1;
+
+        tmp = min;
+        min = max;
+        max = tmp;
+    }
+
+    if(flag & integer_sign)
+        if(min >= 0 && strbuf_putc(strbuf, '+'))
+            return panic("failed to putc strbuf object");
+
+    if(min && divide) {
+        if(min / divide) {
+            if(strbuf_printf(strbuf, "%ld", min / divide))
+                return panic("failed to printf strbuf object");
+        } else if(flag & integer_percent) {
+            if(strbuf_printf(strbuf, "%.2lf", ((double) min) / divide))
+                return panic("failed to printf strbuf object");
+        } else if(strbuf_printf(strbuf, "%ld", min)) {
+            return panic("failed to printf strbuf object");
+        }
+    } else if(strbuf_printf(strbuf, "%ld", min)) {
+        return panic("failed to printf strbuf object");
+    }
+
+    if(flag & integer_percent)
+        if(strbuf_putc(strbuf, '%'))
+            return panic("failed to putc strbuf object");
+
+    if(min != max) {
+        if(strbuf_printf(strbuf, " ~ "))
+            return panic("failed to printf strbuf object");
 
         if(flag & integer_sign)
-            if(min >= 0 && strbuf_putc(strbuf, '+'))
+            if(max >= 0 && strbuf_putc(strbuf, '+'))
                 return panic("failed to putc strbuf object");
 
-        if(min && divide) {
-            if(min / divide) {
-                if(strbuf_printf(strbuf, "%ld", min / divide))
+        if(max && divide) {
+            if(max / divide) {
+                if(strbuf_printf(strbuf, "%ld", max / divide))
                     return panic("failed to printf strbuf object");
             } else if(flag & integer_percent) {
-                if(strbuf_printf(strbuf, "%.2lf", ((double) min) / divide))
+                if(strbuf_printf(strbuf, "%.2lf", ((double) max) / divide))
                     return panic("failed to printf strbuf object");
-            } else if(strbuf_printf(strbuf, "%ld", min)) {
+            } else if(strbuf_printf(strbuf, "%ld", max)) {
                 return panic("failed to printf strbuf object");
             }
-        } else if(strbuf_printf(strbuf, "%ld", min)) {
+        } else if(strbuf_printf(strbuf, "%ld", max)) {
             return panic("failed to printf strbuf object");
         }
 
@@ -2432,39 +4597,12 @@ int argument_integer(struct script * script, struct stack * stack, struct argume
             if(strbuf_putc(strbuf, '%'))
                 return panic("failed to putc strbuf object");
 
-        if(min != max) {
-            if(strbuf_printf(strbuf, " ~ "))
-                return panic("failed to printf strbuf object");
-
-            if(flag & integer_sign)
-                if(max >= 0 && strbuf_putc(strbuf, '+'))
-                    return panic("failed to putc strbuf object");
-
-            if(max && divide) {
-                if(max / divide) {
-                    if(strbuf_printf(strbuf, "%ld", max / divide))
-                        return panic("failed to printf strbuf object");
-                } else if(flag & integer_percent) {
-                    if(strbuf_printf(strbuf, "%.2lf", ((double) max) / divide))
-                        return panic("failed to printf strbuf object");
-                } else if(strbuf_printf(strbuf, "%ld", max)) {
-                    return panic("failed to printf strbuf object");
-                }
-            } else if(strbuf_printf(strbuf, "%ld", max)) {
+        if(flag & integer_string)
+            if(strbuf_printf(strbuf, " (%s)", range->string))
                 return panic("failed to printf strbuf object");
-            }
-
-            if(flag & integer_percent)
-                if(strbuf_putc(strbuf, '%'))
-                    return panic("failed to putc strbuf object");
-
-            if(flag & integer_string)
-                if(strbuf_printf(strbuf, " (%s)", range->string))
-                    return panic("failed to printf strbuf object");
-        }
     }
 
-    return 0;
+return 0;
 }
 
 int argument_string(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
@@ -2485,6 +4623,8 @@ int argument_second(struct script * script, struct stack * stack, struct argumen
 
     long min;
     struct print_node * print;
+    struct integer_node integer;
+    struct argument_node local;
 
     range = stack_get(stack, 0);
     if(!range) {
@@ -2492,25 +4632,30 @@ int argument_second(struct script * script, struct stack * stack, struct argumen
     } else {
         min = range->range->min;
 
+        /* the table is shared, so the divide is set on a copy */
+        local = *argument;
+        local.integer = &integer;
+        integer.flag = argument->integer ? argument->integer->flag : 0;
+
         print = argument->print;
         if(min / 86400) {
-            argument->integer->divide = 86400;
+            integer.divide = 86400;
         } else {
             print = print->next;
             if(min / 3600) {
-                argument->integer->divide = 3600;
+                integer.divide = 3600;
             } else {
                 print = print->next;
                 if(min / 60) {
-                    argument->integer->divide = 60;
+                    integer.divide = 60;
                 } else {
                     print = print->next;
-                    argument->integer->divide = 1;
+                    integer.divide = 1;
                 }
             }
         }
 
-        if(argument_integer(script, stack, argument, strbuf)) {
+        if(argument_integer(script, stack, &local, strbuf)) {
             return panic("failed to integer argument");
         } else if(strbuf_printf(strbuf, " ")) {
             return panic("failed to printf strbuf object");
@@ -2527,6 +4672,8 @@ int argument_millisecond(struct script * script, struct stack * stack, struct ar
 
     long min;
     struct print_node * print;
+    struct integer_node integer;
+    struct argument_node local;
 
     range = stack_get(stack, 0);
     if(!range) {
@@ -2534,30 +4681,35 @@ int argument_millisecond(struct script * script, struct stack * stack, struct ar
     } else {
         min = range->range->min;
 
+        /* the table is shared, so the divide is set on a copy */
+        local = *argument;
+        local.integer = &integer;
+        integer.flag = argument->integer ? argument->integer->flag : 0;
+
         print = argument->print;
         if(min / 86400000) {
-            argument->integer->divide = 86400000;
+            integer.divide = 86400000;
         } else {
             print = print->next;
             if(min / 3600000) {
-                argument->integer->divide = 3600000;
+                integer.divide = 3600000;
             } else {
                 print = print->next;
                 if(min / 60000) {
-                    argument->integer->divide = 60000;
+                    integer.divide = 60000;
                 } else {
                     print = print->next;
                     if(min / 1000) {
-                        argument->integer->divide = 1000;
+                        integer.divide = 1000;
                     } else {
                         print = print->next;
-                        argument->integer->divide = 1;
+                        integer.divide = 1;
                     }
                 }
             }
         }
 
-        if(argument_integer(script, stack, argument, strbuf)) {
+        if(argument_integer(script, stack, &local, strbuf)) {
             return panic("failed to integer argument");
         } else if(strbuf_printf(strbuf, " ")) {
             return panic("failed to printf strbuf object");
@@ -2582,7 +4734,7 @@ int argument_constant(struct script * script, struct stack * stack, struct argum
             return panic("invalid constant - %s", range->string);
         } else if(!constant->tag) {
             return panic("invalid constant tag - %s", range->string);
-        } else if(strbuf_printf(strbuf, "%s", constant->tag)) {
+        } else if(strbuf_printf(strbuf, "%s", locale_tag(script->table, constant))) {
             return panic("failed to printf strbuf object");
         }
     }
@@ -2591,10 +4743,12 @@ int argument_constant(struct script * script, struct stack * stack, struct argum
 }
 
 int argument_item(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
-    long i;
+    char * start;
+    size_t count = 0;
     struct script_range * range;
-    struct range_node * node;
-    struct item_node * item = NULL;
+    struct item_node * item;
+
+    start = strbuf->pos;
 
     range = stack_start(stack);
     while(range) {
@@ -2602,34 +4756,38 @@ int argument_item(struct script * script, struct stack * stack, struct argument_
         if(item) {
             if(strbuf_printf(strbuf, "%s, ", item->name))
                 return panic("failed to printf strbuf object");
-        } else {
-            node = range->range->root;
-            while(node) {
-                for(i = node->min; i <= node->max; i++) {
-                    item = item_id(script->table, i);
-                    if(!item) {
-                        return panic("invalid item id - %ld", i);
-                    } else if(strbuf_printf(strbuf, "%s, ", item->name)) {
-                        return panic("failed to printf strbuf object");
-                    }
-                }
-                node = node->next;
-            }
+            count++;
+        } else if(script_range_name(script, range, strbuf, start, "items", argument_item_name, NULL, &count)) {
+            return panic("failed to name range script object");
         }
         range = stack_next(stack);
     }
 
-    if(item && strbuf_unputn(strbuf, 2))
+    if(count && strbuf_unputn(strbuf, 2))
         return panic("failed to unputn strbuf object");
 
     return 0;
 }
 
+char * argument_item_name(struct script * script, void * context, long i) {
+    struct item_node * item;
+
+    item = item_id(script->table, i);
+    if(!item) {
+        panic("invalid item id - %ld", i);
+        return NULL;
+    }
+
+    return item->name;
+}
+
 int argument_skill(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
-    size_t i;
+    char * start;
+    size_t count = 0;
     struct script_range * range;
-    struct range_node * node;
-    struct skill_node * skill = NULL;
+    struct skill_node * skill;
+
+    start = strbuf->pos;
 
     range = stack_start(stack);
     while(range) {
@@ -2637,34 +4795,38 @@ int argument_skill(struct script * script, struct stack * stack, struct argument
         if(skill) {
             if(strbuf_printf(strbuf, "%s, ", skill->description))
                 return panic("failed to printf strbuf object");
-        } else {
-            node = range->range->root;
-            while(node) {
-                for(i = node->min; i <= node->max; i++) {
-                    skill = skill_id(script->table, i);
-                    if(!skill) {
-                        return panic("invalid skill id - %ld", i);
-                    } else if(strbuf_printf(strbuf, "%s, ", skill->description)) {
-                        return panic("failed to printf strbuf object");
-                    }
-                }
-                node = node->next;
-            }
+            count++;
+        } else if(script_range_name(script, range, strbuf, start, "skills", argument_skill_name, NULL, &count)) {
+            return panic("failed to name range script object");
         }
         range = stack_next(stack);
     }
 
-    if(skill && strbuf_unputn(strbuf, 2))
+    if(count && strbuf_unputn(strbuf, 2))
         return panic("failed to unputn strbuf object");
 
     return 0;
 }
 
+char * argument_skill_name(struct script * script, void * context, long i) {
+    struct skill_node * skill;
+
+    skill = skill_id(script->table, i);
+    if(!skill) {
+        panic("invalid skill id - %ld", i);
+        return NULL;
+    }
+
+    return skill->description;
+}
+
 int argument_mob(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
-    long i;
+    char * start;
+    size_t count = 0;
     struct script_range * range;
-    struct range_node * node;
-    struct mob_node * mob = NULL;
+    struct mob_node * mob;
+
+    start = strbuf->pos;
 
     range = stack_start(stack);
     while(range) {
@@ -2672,62 +4834,65 @@ int argument_mob(struct script * script, struct stack * stack, struct argument_n
         if(mob) {
             if(strbuf_printf(strbuf, "%s, ", mob->kro))
                 return panic("failed to printf strbuf object");
-        } else {
-            node = range->range->root;
-            while(node) {
-                for(i = node->min; i <= node->max; i++) {
-                    mob = mob_id(script->table, i);
-                    if(!mob) {
-                        return panic("invalid mob id - %ld", i);
-                    } else if(strbuf_printf(strbuf, "%s, ", mob->kro)) {
-                        return panic("failed to printf strbuf object");
-                    }
-                }
-                node = node->next;
-            }
+            count++;
+        } else if(script_range_name(script, range, strbuf, start, "monsters", argument_mob_name, NULL, &count)) {
+            return panic("failed to name range script object");
         }
         range = stack_next(stack);
     }
 
-    if(mob && strbuf_unputn(strbuf, 2))
+    if(count && strbuf_unputn(strbuf, 2))
         return panic("failed to unputn strbuf object");
 
     return 0;
 }
 
+char * argument_mob_name(struct script * script, void * context, long i) {
+    struct mob_node * mob;
+
+    mob = mob_id(script->table, i);
+    if(!mob) {
+        panic("invalid mob id - %ld", i);
+        return NULL;
+    }
+
+    return mob->kro;
+}
+
 int argument_mercenary(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
-    long i;
+    char * start;
+    size_t count = 0;
     struct script_range * range;
-    struct range_node * node;
-    struct mercenary_node * mercenary = NULL;
+
+    start = strbuf->pos;
 
     range = stack_start(stack);
     while(range) {
-        node = range->range->root;
-        while(node) {
-            for(i = node->min; i <= node->max; i++) {
-                mercenary = mercenary_id(script->table, i);
-                if(!mercenary) {
-                    return panic("invalid mercenary id - %ld", i);
-                } else if(strbuf_printf(strbuf, "%s, ", mercenary->name)) {
-                    return panic("failed to printf strbuf object");
-                }
-            }
-            node = node->next;
-        }
+        if(script_range_name(script, range, strbuf, start, "mercenaries", argument_mercenary_name, NULL, &count))
+            return panic("failed to name range script object");
         range = stack_next(stack);
     }
 
-    if(mercenary && strbuf_unputn(strbuf, 2))
+    if(count && strbuf_unputn(strbuf, 2))
         return panic("failed to unputn strbuf object");
 
     return 0;
 }
 
-int argument_group(struct script * script, struct stack * stack, struct strbuf * strbuf, char * group) {
-    long i;
-    struct range_node * node;
+char * argument_mercenary_name(struct script * script, void * context, long i) {
+    struct mercenary_node * mercenary;
+
+    mercenary = mercenary_id(script->table, i);
+    if(!mercenary) {
+        panic("invalid mercenary id - %ld", i);
+        return NULL;
+    }
 
+    return mercenary->name;
+}
+
+int argument_group(struct script * script, struct stack * stack, struct strbuf * strbuf, char * group) {
+    size_t count = 0;
     struct script_range * range;
     struct constant_node * constant;
     struct constant_group_node * constant_group;
@@ -2742,29 +4907,30 @@ int argument_group(struct script * script, struct stack * stack, struct strbuf *
 
     constant = map_search(&constant_group->map_identifier, range->string);
     if(constant) {
-        if(strbuf_printf(strbuf, "%s", constant->tag))
+        if(strbuf_printf(strbuf, "%s", locale_tag(script->table, constant)))
             return panic("failed to printf strbuf object");
-    } else {
-        node = range->range->root;
-        while(node) {
-            for(i = node->min; i <= node->max; i++) {
-                constant = map_search(&constant_group->map_value, &i);
-                if(!constant) {
-                    return panic("invalid constant value - %ld", i);
-                } else if(strbuf_printf(strbuf, "%s, ", constant->tag)) {
-                    return panic("failed to printf strbuf object");
-                }
-            }
-            node = node->next;
-        }
-
-        if(constant && strbuf_unputn(strbuf, 2))
-            return panic("failed to unputn strbuf object");
+    } else if(script_range_name(script, range, strbuf, strbuf->pos, "values", argument_group_name, constant_group, &count)) {
+        return panic("failed to name range script object");
+    } else if(count && strbuf_unputn(strbuf, 2)) {
+        return panic("failed to unputn strbuf object");
     }
 
     return 0;
 }
 
+char * argument_group_name(struct script * script, void * context, long i) {
+    struct constant_node * constant;
+    struct constant_group_node * constant_group = context;
+
+    constant = map_search(&constant_group->map_value, &i);
+    if(!constant) {
+        panic("invalid constant value - %ld", i);
+        return NULL;
+    }
+
+    return locale_tag(script->table, constant);
+}
+
 int argument_element(struct script * script, struct stack * stack, struct argument_node * argument, struct strbuf * strbuf) {
     return argument_group(script, stack, strbuf, "element");
 }
@@ -3005,7 +5171,10 @@ int argument_script(struct script * script, struct stack * stack, struct argumen
     if(!range)
         return panic("failed to get stack object");
 
-    if(script_generate(script, range->string, strbuf))
+    if(script_parse(script, range->string))
+        return panic("failed to parse script object");
+
+    if(script_generate(script, script->root, strbuf))
         return panic("failed to compile script object");
 
     return 0;
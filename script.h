@@ -1,16 +1,95 @@
 #ifndef script_h
 #define script_h
 
+#include <limits.h>
+#include <stdint.h>
+
 #include "table.h"
 
-struct script_node {
+#define SCRIPT_BUDGET_STEP 100000
+#define SCRIPT_BUDGET_WIDTH 256
+#define SCRIPT_BUDGET_OUTPUT 3072
+#define SCRIPT_BUDGET_LIST 512
+#define SCRIPT_BUDGET_RESERVE 64
+#define SCRIPT_LOOP_WIDEN 3
+#define SCRIPT_LOOP_MAX 8
+#define SCRIPT_CALL_MAX 8
+
+struct script_tree {
     int token;
     union {
         long integer;
         char * identifier;
     };
-    struct script_node * root;
-    struct script_node * next;
+    char * string;
+    struct script_tree * root;
+    struct script_tree * next;
+};
+
+/* the parsed script is laid out in one block with the nodes in preorder and
+ * their text after them; links are 32-bit offsets from the node (0 for none)
+ * so the block can be copied as it is */
+struct script_node {
+    int token;
+    int root;
+    int next;
+    int string;
+    union {
+        long integer;
+        int identifier;
+    };
+};
+
+static inline struct script_node * script_node_root(struct script_node * node) {
+    return node->root ? node + node->root : NULL;
+}
+
+static inline struct script_node * script_node_next(struct script_node * node) {
+    return node->next ? node + node->next : NULL;
+}
+
+static inline char * script_node_identifier(struct script_node * node) {
+    return (char *) node + node->identifier;
+}
+
+static inline char * script_node_string(struct script_node * node) {
+    return node->string ? (char *) node + node->string : NULL;
+}
+
+#define SCRIPT_CODE_REGISTER 16
+
+/* an expression compiled from the node block into instructions that read
+ * and write registers in order; a node without an instruction of its own is
+ * evaluated by the tree walk into its register */
+enum script_opcode {
+    code_return,
+    code_evaluate,
+    code_integer,
+    code_string,
+    code_plus,
+    code_minus,
+    code_multiply,
+    code_divide,
+    code_remainder,
+    code_bit_or,
+    code_bit_xor,
+    code_bit_and,
+    code_bit_left,
+    code_bit_right,
+    code_plus_unary,
+    code_minus_unary,
+    code_bit_not,
+    code_assign,
+    code_plus_assign,
+    code_minus_assign
+};
+
+struct script_code {
+    int opcode;
+    int target;
+    int left;
+    int right;
+    struct script_node * node;
 };
 
 enum script_type {
@@ -19,11 +98,31 @@ enum script_type {
     string
 };
 
+/* the string is built on first read from the format and the strings of
+ * the left and right ranges in place of each %s */
 struct script_range {
     enum script_type type;
     struct range * range;
     char * string;
-    struct script_range * next;
+    size_t length;
+    char * format;
+    struct script_range * left;
+    struct script_range * right;
+};
+
+struct script_value {
+    enum script_type type;
+    char * identifier;
+    char * string;
+    struct range_node * range;
+    struct script_value * next;
+};
+
+struct script_summary {
+    size_t step;
+    char * string;
+    struct script_value * result;
+    struct script_value * effect;
 };
 
 struct script_buffer {
@@ -46,35 +145,74 @@ struct undefined {
 int undefined_create(struct undefined *, size_t, struct heap *);
 void undefined_destroy(struct undefined *);
 int undefined_add(struct undefined *, char *, ...);
+void undefined_clear(struct undefined *);
 void undefined_print(struct undefined *);
 
+/* render_list is generated by the render tool with a function for each
+ * template that writes it without walking its entries */
+struct render_entry {
+    char * table;
+    char * identifier;
+    unsigned long digest;
+    argument_cb render;
+};
+
+extern struct render_entry render_list[];
+
+unsigned long argument_digest(struct argument_node *);
+int argument_integer_write(struct strbuf *, struct script_range *, long, long);
+int entry_node_call(struct entry_node *, struct script *, struct stack *, struct strbuf *);
+struct entry_node * render_entry_at(struct argument_node *, size_t, size_t);
+int render_load(struct stack *, struct stack *, size_t, ...);
+int render_integer(struct script *, struct stack *, long, long, struct strbuf *);
+
 struct script {
     struct heap * heap;
     struct table * table;
     void * scanner;
     void * parser;
     struct store store;
+    struct zone zone;
+    struct pool range_pool;
+    struct pool logic_pool;
+    struct pool map_pool;
     struct stack map_stack;
     struct stack logic_stack;
     struct stack stack_stack;
     struct stack strbuf_stack;
     struct stack map_logic_stack;
     struct map function;
-    struct map argument;
     struct script_buffer buffer;
     struct undefined undefined;
+    struct store summary_store;
+    struct map summary;
+    struct script * callee;
+    struct script_tree * tree;
     struct script_node * root;
     struct map * map;
     struct logic * logic;
     struct stack * stack;
     struct strbuf * strbuf;
     struct map * map_logic;
-    struct script_range * range;
+    struct strbuf * output;
+    struct script_range ** argument;
+    size_t argument_count;
+    struct script_range * result;
+    size_t depth;
+    size_t step;
+    int exhausted;
+    int check;
 };
 
-int script_setup(struct table *);
+int script_setup(struct table *, struct heap *, struct render_entry *);
 int script_create(struct script *, size_t, struct heap *, struct table *);
 void script_destroy(struct script *);
 int script_compile(struct script *, char *, struct strbuf *);
+int script_compile_locale(struct script *, char *, struct strbuf *, size_t);
+
+typedef int (* script_reference_cb) (char *, void *);
+
+int script_reference(struct script *, char *, script_reference_cb, void *);
+int script_branch(struct script *, char *, int *);
 
 #endif
@@ -0,0 +1,289 @@
+#include "seek.h"
+
+#include <unistd.h>
+
+int seek_path(struct sidecar_map *, struct strbuf *, char *, char *, char *, seek_key_cb);
+int seek_build(char *, char *, seek_key_cb);
+int seek_id(char **, char *, long *);
+long seek_hash(char *, size_t);
+int seek_row(struct seek *, char *, size_t);
+int seek_item_row(char *, size_t, void *);
+int seek_name_row(char *, size_t, void *);
+int seek_combo_row(char *, size_t, void *);
+int seek_miss(void *, long, char *);
+
+int seek_create(struct seek * seek, struct table * table, struct strbuf * strbuf, char * path) {
+    int status = 0;
+
+    if(seek_path(&seek->id, strbuf, path, "item_db.txt", "idx", seek_id_key)) {
+        status = 1;
+    } else {
+        if(seek_path(&seek->name, strbuf, path, "item_db.txt", "name.idx", seek_name_key)) {
+            status = 1;
+        } else {
+            if(seek_path(&seek->combo, strbuf, path, "item_combo_db.txt", "idx", seek_combo_key)) {
+                status = 1;
+            } else {
+                seek->table = table;
+                item_miss(table, seek_miss, seek);
+            }
+            if(status)
+                sidecar_map_close(&seek->name);
+        }
+        if(status)
+            sidecar_map_close(&seek->id);
+    }
+
+    return status;
+}
+
+void seek_destroy(struct seek * seek) {
+    item_miss(seek->table, NULL, NULL);
+    sidecar_map_close(&seek->combo);
+    sidecar_map_close(&seek->name);
+    sidecar_map_close(&seek->id);
+}
+
+int seek_item(struct seek * seek, long id) {
+    char * string;
+    size_t length;
+
+    /* an unknown id is reported by the caller */
+    if(sidecar_map_find(&seek->id, id, &string, &length))
+        return 0;
+
+    if(seek_row(seek, string, length))
+        return panic("failed to row seek object - %ld", id);
+
+    if(sidecar_map_each(&seek->combo, id, seek_combo_row, seek))
+        return panic("failed to combo seek object - %ld", id);
+
+    return 0;
+}
+
+int seek_row(struct seek * seek, char * string, size_t length) {
+    long id;
+    char * cursor = string;
+
+    if(seek_id(&cursor, string + length, &id))
+        return panic("invalid row");
+
+    if(map_search(&seek->table->item.id, &id))
+        return 0;
+
+    return table_item_bytes_parse(seek->table, string, length);
+}
+
+int seek_item_row(char * string, size_t length, void * context) {
+    return seek_row(context, string, length);
+}
+
+int seek_combo_row(char * string, size_t length, void * context) {
+    struct seek * seek = context;
+
+    long id;
+    char * cursor;
+    char * end;
+    char * row;
+    size_t size;
+
+    /* the combo's other items are loaded before the combo row */
+    cursor = string;
+    end = string + length;
+    while(!seek_id(&cursor, end, &id)) {
+        if(map_search(&seek->table->item.id, &id)) {
+            /* skip */
+        } else if(sidecar_map_find(&seek->id, id, &row, &size)) {
+            return panic("invalid item id - %ld", id);
+        } else if(seek_row(seek, row, size)) {
+            return panic("failed to row seek object - %ld", id);
+        }
+
+        if(cursor == end || *cursor != ':')
+            break;
+        cursor++;
+    }
+
+    return table_item_combo_bytes_parse(seek->table, string, length);
+}
+
+int seek_miss(void * context, long id, char * name) {
+    struct seek * seek = context;
+
+    char * string;
+    size_t length;
+
+    if(name) {
+        if(sidecar_map_each(&seek->name, seek_hash(name, strlen(name)), seek_item_row, seek))
+            return panic("failed to each sidecar map object");
+    } else {
+        if(sidecar_map_find(&seek->id, id, &string, &length))
+            return 1;
+        if(seek_row(seek, string, length))
+            return panic("failed to row seek object - %ld", id);
+    }
+
+    return 0;
+}
+
+int seek_path(struct sidecar_map * map, struct strbuf * strbuf, char * path, char * file, char * extension, seek_key_cb key) {
+    char * data;
+    char * index;
+
+    strbuf_clear(strbuf);
+    if(strbuf_printf(strbuf, "%s/%s", path, file)) {
+        return panic("failed to printf strbuf object");
+    } else if(!(data = strbuf_array(strbuf))) {
+        return panic("failed to array strbuf object");
+    } else if(strbuf_printf(strbuf, "%s.%s", data, extension)) {
+        return panic("failed to printf strbuf object");
+    } else if(!(index = strbuf_array(strbuf))) {
+        return panic("failed to array strbuf object");
+    }
+
+    return seek_open(map, data, index, key);
+}
+
+int seek_open(struct sidecar_map * map, char * data, char * index, seek_key_cb key) {
+    int status;
+    int quiet;
+    uint64_t size;
+    uint64_t mtime;
+
+    /* a missing data file is parsed the slow way */
+    if(sidecar_stat(data, &size, &mtime))
+        return 1;
+
+    if(!access(index, R_OK) && !sidecar_map_open(map, data, index)) {
+        if(map->header->data_size == size && map->header->data_mtime == mtime)
+            return 0;
+        sidecar_map_close(map);
+    }
+
+    /* an index that cannot be written (e.g. a read-only data
+     * directory) is not an error; the file is parsed the slow way */
+    quiet = panic_quiet(1);
+    status = seek_build(data, index, key);
+    panic_quiet(quiet);
+    if(status)
+        return 1;
+
+    if(sidecar_map_open(map, data, index))
+        return panic("failed to open sidecar map object");
+
+    return 0;
+}
+
+int seek_build(char * data, char * index, seek_key_cb key) {
+    int status = 0;
+
+    struct sidecar sidecar;
+    struct sidecar_map map;
+    char * string;
+    char * end;
+    char * line;
+
+    if(sidecar_create(&sidecar, 4096)) {
+        status = panic("failed to create sidecar object");
+    } else {
+        if(sidecar_stat(data, &sidecar.data_size, &sidecar.data_mtime)) {
+            status = panic("failed to stat %s", data);
+        } else if(sidecar_map_open(&map, data, NULL)) {
+            status = panic("failed to open sidecar map object");
+        } else {
+            string = map.data;
+            end = map.data + map.data_size;
+            while(string < end && !status) {
+                line = memchr(string, '\n', end - string);
+                line = line ? line + 1 : end;
+
+                if(line - string < 2 || (string[0] == '/' && string[1] == '/')) {
+                    /* skip */
+                } else if(key(&sidecar, string, line - string, string - map.data)) {
+                    status = panic("failed to key row");
+                }
+
+                string = line;
+            }
+
+            sidecar_map_close(&map);
+
+            if(!status && sidecar_write(&sidecar, index))
+                status = panic("failed to write sidecar object");
+        }
+        sidecar_destroy(&sidecar);
+    }
+
+    return status;
+}
+
+int seek_id(char ** string, char * end, long * id) {
+    char * cursor = *string;
+
+    if(cursor == end || !isdigit(*cursor))
+        return 1;
+
+    *id = 0;
+    while(cursor < end && isdigit(*cursor))
+        *id = *id * 10 + (*cursor++ - '0');
+
+    *string = cursor;
+
+    return 0;
+}
+
+long seek_hash(char * string, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;
+
+    while(length--) {
+        hash ^= (unsigned char) *string++;
+        hash *= 1099511628211ULL;
+    }
+
+    return hash & INT64_MAX;
+}
+
+int seek_id_key(struct sidecar * sidecar, char * string, size_t length, size_t offset) {
+    long id;
+
+    if(seek_id(&string, string + length, &id))
+        return 0;
+
+    return sidecar_add(sidecar, id, offset, length);
+}
+
+int seek_name_key(struct sidecar * sidecar, char * string, size_t length, size_t offset) {
+    size_t i;
+    char * end = string + length;
+    char * name = string;
+
+    /* the name is the third field */
+    for(i = 0; i < 2 && name < end; i++) {
+        name = memchr(name, ',', end - name);
+        if(!name)
+            return 0;
+        name++;
+    }
+
+    end = memchr(name, ',', end - name);
+    if(!end)
+        return 0;
+
+    return sidecar_add(sidecar, seek_hash(name, end - name), offset, length);
+}
+
+int seek_combo_key(struct sidecar * sidecar, char * string, size_t length, size_t offset) {
+    long id;
+    char * end = string + length;
+
+    while(!seek_id(&string, end, &id)) {
+        if(sidecar_add(sidecar, id, offset, length))
+            return panic("failed to add sidecar object");
+
+        if(string == end || *string != ':')
+            break;
+        string++;
+    }
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#ifndef seek_h
+#define seek_h
+
+#include "table.h"
+#include "sidecar.h"
+
+typedef int (* seek_key_cb) (struct sidecar *, char *, size_t, size_t);
+
+struct seek {
+    struct table * table;
+    struct sidecar_map id;
+    struct sidecar_map name;
+    struct sidecar_map combo;
+};
+
+int seek_create(struct seek *, struct table *, struct strbuf *, char *);
+void seek_destroy(struct seek *);
+int seek_item(struct seek *, long);
+int seek_open(struct sidecar_map *, char *, char *, seek_key_cb);
+int seek_id_key(struct sidecar *, char *, size_t, size_t);
+int seek_name_key(struct sidecar *, char *, size_t, size_t);
+int seek_combo_key(struct sidecar *, char *, size_t, size_t);
+
+#endif
@@ -0,0 +1,211 @@
+#include "select.h"
+
+int long_compare(void *, void *);
+
+int select_add(struct select *, struct item_node *);
+int select_range(struct select *, char *, size_t);
+int select_file_parse(enum csv_event, int, struct string *, void *);
+int select_list(struct map *, struct store *, char *, struct item_node *);
+int select_index(struct select *, struct script *);
+int select_index_parse(char *, void *);
+
+int select_create(struct select * select, size_t size, struct heap * heap, struct table * table) {
+    int status = 0;
+
+    select->table = table;
+    select->current = NULL;
+    select->index = 0;
+
+    if(store_create(&select->store, size)) {
+        status = panic("failed to create store object");
+    } else {
+        if(map_create(&select->item, long_compare, heap->map_pool)) {
+            status = panic("failed to create map object");
+        } else {
+            if(map_create(&select->name, (map_compare_cb) strcmp, heap->map_pool)) {
+                status = panic("failed to create map object");
+            } else {
+                if(map_create(&select->reference, (map_compare_cb) strcmp, heap->map_pool))
+                    status = panic("failed to create map object");
+                if(status)
+                    map_destroy(&select->name);
+            }
+            if(status)
+                map_destroy(&select->item);
+        }
+        if(status)
+            store_destroy(&select->store);
+    }
+
+    return status;
+}
+
+void select_destroy(struct select * select) {
+    map_destroy(&select->reference);
+    map_destroy(&select->name);
+    map_destroy(&select->item);
+    store_destroy(&select->store);
+}
+
+int select_add(struct select * select, struct item_node * item) {
+    if(map_search(&select->item, &item->id))
+        return 0;
+
+    return map_insert(&select->item, &item->id, item);
+}
+
+int select_range(struct select * select, char * string, size_t length) {
+    long min;
+    long max;
+    char * last;
+    struct item_node * item;
+
+    min = strtol(string, &last, 0);
+    max = min;
+    if(last != string && last < string + length && *last == '-')
+        max = strtol(last + 1, &last, 0);
+
+    if(last != string + length || min > max)
+        return panic("invalid item id - %.*s", (int) length, string);
+
+    item = item_id_lower(select->table, min);
+    while(item && item->id <= max) {
+        if(select_add(select, item))
+            return panic("failed to add select object");
+        item = item_next(select->table);
+    }
+
+    return 0;
+}
+
+int select_id(struct select * select, char * string) {
+    return select_range(select, string, strlen(string));
+}
+
+int select_file(struct select * select, char * path) {
+    return csv_parse(path, select_file_parse, select);
+}
+
+int select_file_parse(enum csv_event event, int mark, struct string * string, void * context) {
+    struct select * select = context;
+
+    if(event == csv_next && string->length)
+        if(select_range(select, string->string, string->length))
+            return panic("failed to range select object");
+
+    return 0;
+}
+
+int select_name(struct select * select, struct script * script, char * prefix) {
+    size_t length;
+    struct map_kv kv;
+    struct select_node * node;
+
+    if(!select->index && select_index(select, script))
+        return panic("failed to index select object");
+
+    length = strlen(prefix);
+
+    kv = map_lower(&select->name, prefix);
+    while(kv.key && !strncmp(kv.key, prefix, length)) {
+        node = kv.value;
+        while(node) {
+            if(select_add(select, node->item))
+                return panic("failed to add select object");
+            node = node->next;
+        }
+        kv = map_next(&select->name);
+    }
+
+    return 0;
+}
+
+int select_reference(struct select * select, struct script * script, char * identifier) {
+    struct select_node * node;
+
+    if(!select->index && select_index(select, script))
+        return panic("failed to index select object");
+
+    node = map_search(&select->reference, identifier);
+    while(node) {
+        if(select_add(select, node->item))
+            return panic("failed to add select object");
+        node = node->next;
+    }
+
+    return 0;
+}
+
+int select_list(struct map * map, struct store * store, char * key, struct item_node * item) {
+    struct select_node * node;
+    struct select_node * root;
+
+    root = map_search(map, key);
+    if(root && root->item == item)
+        return 0;
+
+    node = store_malloc(store, sizeof(*node));
+    if(!node) {
+        return panic("failed to malloc store object");
+    } else if(root) {
+        *node = *root;
+        root->item = item;
+        root->next = node;
+    } else {
+        node->item = item;
+        node->next = NULL;
+
+        key = store_strcpy(store, key, strlen(key));
+        if(!key) {
+            return panic("failed to strcpy store object");
+        } else if(map_insert(map, key, node)) {
+            return panic("failed to insert map object");
+        }
+    }
+
+    return 0;
+}
+
+int select_index(struct select * select, struct script * script) {
+    struct item_node * item;
+    struct item_combo_node * combo;
+
+    item = item_start(select->table);
+    while(item) {
+        select->current = item;
+
+        if(select_list(&select->name, &select->store, item->name, item))
+            return panic("failed to list select object");
+
+        if(item->bonus && script_reference(script, item->bonus, select_index_parse, select))
+            return panic("failed to reference script object - %ld", item->id);
+
+        combo = item->combo;
+        while(combo) {
+            if(script_reference(script, combo->bonus, select_index_parse, select))
+                return panic("failed to reference script object - %ld", item->id);
+            combo = combo->next;
+        }
+
+        item = item_next(select->table);
+    }
+
+    select->current = NULL;
+    select->index = 1;
+
+    return 0;
+}
+
+int select_index_parse(char * identifier, void * context) {
+    struct select * select = context;
+
+    return select_list(&select->reference, &select->store, identifier, select->current);
+}
+
+struct item_node * select_start(struct select * select) {
+    return map_start(&select->item).value;
+}
+
+struct item_node * select_next(struct select * select) {
+    return map_next(&select->item).value;
+}
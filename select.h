@@ -0,0 +1,30 @@
+#ifndef select_h
+#define select_h
+
+#include "script.h"
+
+struct select_node {
+    struct item_node * item;
+    struct select_node * next;
+};
+
+struct select {
+    struct table * table;
+    struct store store;
+    struct map item;
+    struct map name;
+    struct map reference;
+    struct item_node * current;
+    int index;
+};
+
+int select_create(struct select *, size_t, struct heap *, struct table *);
+void select_destroy(struct select *);
+int select_id(struct select *, char *);
+int select_file(struct select *, char *);
+int select_name(struct select *, struct script *, char *);
+int select_reference(struct select *, struct script *, char *);
+struct item_node * select_start(struct select *);
+struct item_node * select_next(struct select *);
+
+#endif
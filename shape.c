@@ -0,0 +1,344 @@
+#include "shape.h"
+
+int shape_key(struct shape *, char *, char **);
+int shape_word(char);
+char * shape_source(struct shape *, char *, long *);
+int shape_build(struct shape *, char *, size_t, struct shape_node **);
+int shape_plan(struct shape *, struct shape_node *, long *, size_t);
+int shape_check(struct shape *, struct shape_node *, long *, size_t);
+int shape_render(struct strbuf *, char *, long *);
+int shape_range(struct shape *);
+
+int shape_create(struct shape * shape, size_t size, struct heap * heap, struct script * script) {
+    int status = 0;
+
+    size_t i;
+
+    if(store_create(&shape->store, size)) {
+        status = panic("failed to create store object");
+    } else if(map_create(&shape->map, (map_compare_cb) strcmp, heap->map_pool)) {
+        status = panic("failed to create map object");
+        goto map_fail;
+    } else if(strbuf_create(&shape->key, size)) {
+        status = panic("failed to create strbuf object");
+        goto key_fail;
+    } else if(strbuf_create(&shape->source, size)) {
+        status = panic("failed to create strbuf object");
+        goto source_fail;
+    } else if(strbuf_create(&shape->scratch, size)) {
+        status = panic("failed to create strbuf object");
+        goto scratch_fail;
+    } else {
+        for(i = 0; i < LOCALE_MAX && !status; i++)
+            if(strbuf_create(&shape->probe[i], size))
+                status = panic("failed to create strbuf object");
+
+        if(status)
+            goto probe_fail;
+
+        shape->script = script;
+        shape->count = 0;
+    }
+
+    return status;
+
+probe_fail:
+    while(--i > 0)
+        strbuf_destroy(&shape->probe[i - 1]);
+    strbuf_destroy(&shape->scratch);
+scratch_fail:
+    strbuf_destroy(&shape->source);
+source_fail:
+    strbuf_destroy(&shape->key);
+key_fail:
+    map_destroy(&shape->map);
+map_fail:
+    store_destroy(&shape->store);
+
+    return status;
+}
+
+void shape_destroy(struct shape * shape) {
+    size_t i;
+
+    for(i = 0; i < LOCALE_MAX; i++)
+        strbuf_destroy(&shape->probe[i]);
+    strbuf_destroy(&shape->scratch);
+    strbuf_destroy(&shape->source);
+    strbuf_destroy(&shape->key);
+    map_destroy(&shape->map);
+    store_destroy(&shape->store);
+}
+
+int shape_compile(struct shape * shape, char * string, struct strbuf * strbuf, size_t count) {
+    size_t i;
+    char * key;
+    struct shape_node * node;
+
+    if(shape_key(shape, string, &key))
+        return panic("failed to key shape object");
+
+    node = map_search(&shape->map, key);
+    if(!node) {
+        if(shape_build(shape, key, count, &node))
+            return panic("failed to build shape object");
+    } else if(!node->fallback && shape_range(shape)) {
+        for(i = 0; i < count; i++)
+            if(shape_render(&strbuf[i], node->plan[i], shape->value))
+                return panic("failed to render shape object");
+
+        return 0;
+    }
+
+    if(script_compile_locale(shape->script, string, strbuf, count))
+        return panic("failed to compile script object");
+
+    return 0;
+}
+
+int shape_key(struct shape * shape, char * string, char ** result) {
+    char * cursor;
+    char * anchor;
+
+    strbuf_clear(&shape->key);
+    shape->count = 0;
+
+    cursor = string;
+    while(*cursor) {
+        anchor = cursor;
+        if(*cursor == '"') {
+            /* string */
+            cursor++;
+            while(*cursor && *cursor != '"')
+                cursor += (*cursor == '\\' && cursor[1]) ? 2 : 1;
+            if(*cursor)
+                cursor++;
+        } else if(cursor[0] == '/' && cursor[1] == '/') {
+            /* line comment */
+            while(*cursor && *cursor != '\n')
+                cursor++;
+        } else if(cursor[0] == '/' && cursor[1] == '*') {
+            /* block comment */
+            cursor += 2;
+            while(*cursor && !(cursor[0] == '*' && cursor[1] == '/'))
+                cursor++;
+            if(*cursor)
+                cursor += 2;
+        } else if(isdigit(*cursor)) {
+            while(isdigit(*cursor))
+                cursor++;
+
+            /* identifier, index and hexadecimal digits are part of the shape */
+            if( shape->count < SHAPE_SLOT &&
+                cursor - anchor < 10 &&
+                (anchor == string || !shape_word(anchor[-1])) &&
+                !shape_word(*cursor) ) {
+                shape->value[shape->count++] = strtol(anchor, NULL, 10);
+                if(strbuf_putc(&shape->key, SHAPE_HOLE))
+                    return panic("failed to putc strbuf object");
+                continue;
+            }
+        } else {
+            cursor++;
+        }
+
+        if(strbuf_strcpy(&shape->key, anchor, cursor - anchor))
+            return panic("failed to strcpy strbuf object");
+    }
+
+    *result = strbuf_array(&shape->key);
+    if(!*result)
+        return panic("failed to array strbuf object");
+
+    return 0;
+}
+
+int shape_word(char c) {
+    return isalnum(c) || c == '_' || c == '[' || c == '$' || c == '@' || c == '.' || c == '\'' || c == '#';
+}
+
+char * shape_source(struct shape * shape, char * key, long * value) {
+    size_t i = 0;
+
+    strbuf_clear(&shape->source);
+
+    while(*key) {
+        if(*key == SHAPE_HOLE) {
+            if(strbuf_printf(&shape->source, "%ld", value[i++]))
+                return NULL;
+        } else if(strbuf_putc(&shape->source, *key)) {
+            return NULL;
+        }
+        key++;
+    }
+
+    if(strbuf_putc(&shape->source, 0))
+        return NULL;
+
+    return strbuf_array(&shape->source);
+}
+
+int shape_build(struct shape * shape, char * key, size_t count, struct shape_node ** result) {
+    int quiet;
+    int branch;
+    size_t i;
+    long value[SHAPE_SLOT];
+
+    char * source;
+    struct shape_node * node;
+
+    node = store_calloc(&shape->store, sizeof(*node));
+    if(!node)
+        return panic("failed to calloc store object");
+
+    node->fallback = 1;
+
+    key = store_strcpy(&shape->store, key, strlen(key));
+    if(!key)
+        return panic("failed to strcpy store object");
+
+    if(map_insert(&shape->map, key, node))
+        return panic("failed to insert map object");
+
+    /* translate with distinct sentinels to find the holes */
+    for(i = 0; i < shape->count; i++)
+        value[i] = SHAPE_BASE + SHAPE_STEP * i;
+
+    source = shape_source(shape, key, value);
+    if(!source)
+        return panic("failed to source shape object");
+
+    /* a sentinel that is not a valid id is not an error */
+    quiet = panic_quiet(1);
+    if(shape->count && (script_branch(shape->script, source, &branch) || branch)) {
+        /* the output of a literal that decides a branch is not linear */
+        node->fallback = 1;
+    } else if(script_compile_locale(shape->script, source, shape->probe, count)) {
+        node->fallback = 1;
+    } else if(shape_plan(shape, node, value, count)) {
+        node->fallback = 1;
+    } else if(shape->count) {
+        /* translate with the smallest value to check the plan */
+        for(i = 0; i < shape->count; i++)
+            value[i] = 1;
+
+        source = shape_source(shape, key, value);
+        if(!source || script_compile_locale(shape->script, source, shape->probe, count)) {
+            node->fallback = 1;
+        } else {
+            node->fallback = shape_check(shape, node, value, count);
+        }
+    }
+    panic_quiet(quiet);
+
+    *result = node;
+
+    return 0;
+}
+
+int shape_plan(struct shape * shape, struct shape_node * node, long * value, size_t count) {
+    size_t i;
+    size_t j;
+    long integer;
+    char * cursor;
+    char * anchor;
+    char * end;
+    char found[SHAPE_SLOT];
+
+    memset(found, 0, sizeof(found));
+
+    for(i = 0; i < count; i++) {
+        strbuf_clear(&shape->scratch);
+
+        cursor = shape->probe[i].str;
+        end = shape->probe[i].pos;
+        if(end - cursor > SCRIPT_BUDGET_OUTPUT)
+            return 1;
+
+        while(cursor < end) {
+            anchor = cursor;
+            if(*cursor == SHAPE_HOLE) {
+                return 1;
+            } else if(isdigit(*cursor)) {
+                while(cursor < end && isdigit(*cursor))
+                    cursor++;
+
+                integer = strtol(anchor, NULL, 10);
+                j = (integer - SHAPE_BASE) / SHAPE_STEP;
+                if( integer >= SHAPE_BASE &&
+                    j < shape->count &&
+                    value[j] == integer ) {
+                    found[j] = 1;
+                    if(strbuf_putc(&shape->scratch, SHAPE_HOLE) || strbuf_putc(&shape->scratch, j + 1))
+                        return panic("failed to putc strbuf object");
+                    continue;
+                }
+            } else {
+                cursor++;
+            }
+
+            if(strbuf_strcpy(&shape->scratch, anchor, cursor - anchor))
+                return panic("failed to strcpy strbuf object");
+        }
+
+        node->plan[i] = store_strcpy(&shape->store, shape->scratch.str, shape->scratch.pos - shape->scratch.str);
+        if(!node->plan[i])
+            return panic("failed to strcpy store object");
+    }
+
+    /* a literal that does not reach the output may decide a condition */
+    for(j = 0; j < shape->count; j++)
+        if(!found[j])
+            return 1;
+
+    return 0;
+}
+
+int shape_check(struct shape * shape, struct shape_node * node, long * value, size_t count) {
+    size_t i;
+    size_t length;
+
+    for(i = 0; i < count; i++) {
+        if(shape_render(&shape->scratch, node->plan[i], value))
+            return 1;
+
+        length = shape->scratch.pos - shape->scratch.str;
+        if( length != shape->probe[i].pos - shape->probe[i].str ||
+            memcmp(shape->scratch.str, shape->probe[i].str, length) )
+            return 1;
+    }
+
+    return 0;
+}
+
+int shape_render(struct strbuf * strbuf, char * plan, long * value) {
+    size_t length;
+
+    strbuf_clear(strbuf);
+
+    while(*plan) {
+        if(*plan == SHAPE_HOLE) {
+            if(strbuf_printf(strbuf, "%ld", value[(unsigned char) plan[1] - 1]))
+                return panic("failed to printf strbuf object");
+            plan += 2;
+        } else {
+            length = strcspn(plan, "\x01");
+            if(strbuf_strcpy(strbuf, plan, length))
+                return panic("failed to strcpy strbuf object");
+            plan += length;
+        }
+    }
+
+    return 0;
+}
+
+int shape_range(struct shape * shape) {
+    size_t i;
+
+    /* the plan is checked between the smallest value and the sentinels */
+    for(i = 0; i < shape->count; i++)
+        if(shape->value[i] < 1 || shape->value[i] >= SHAPE_BASE)
+            return 0;
+
+    return 1;
+}
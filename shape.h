@@ -0,0 +1,32 @@
+#ifndef shape_h
+#define shape_h
+
+#include "script.h"
+
+#define SHAPE_SLOT 64
+#define SHAPE_HOLE '\x01'
+#define SHAPE_BASE 5003
+#define SHAPE_STEP 17
+
+struct shape_node {
+    int fallback;
+    char * plan[LOCALE_MAX];
+};
+
+struct shape {
+    struct script * script;
+    struct store store;
+    struct map map;
+    struct strbuf key;
+    struct strbuf source;
+    struct strbuf scratch;
+    struct strbuf probe[LOCALE_MAX];
+    long value[SHAPE_SLOT];
+    size_t count;
+};
+
+int shape_create(struct shape *, size_t, struct heap *, struct script *);
+void shape_destroy(struct shape *);
+int shape_compile(struct shape *, char *, struct strbuf *, size_t);
+
+#endif
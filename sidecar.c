@@ -0,0 +1,230 @@
+#include "sidecar.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+uint64_t sidecar_hash(int64_t);
+int sidecar_mmap(char *, char **, size_t *);
+
+uint64_t sidecar_hash(int64_t id) {
+    return (uint64_t) id * 11400714819323198485ULL;
+}
+
+int sidecar_create(struct sidecar * sidecar, size_t size) {
+    int status = 0;
+
+    if(store_create(&sidecar->store, size)) {
+        status = panic("failed to create store object");
+    } else {
+        sidecar->root = NULL;
+        sidecar->count = 0;
+        sidecar->data_size = 0;
+        sidecar->data_mtime = 0;
+    }
+
+    return status;
+}
+
+void sidecar_destroy(struct sidecar * sidecar) {
+    store_destroy(&sidecar->store);
+}
+
+int sidecar_add(struct sidecar * sidecar, long id, size_t offset, size_t length) {
+    struct sidecar_node * node;
+
+    node = store_malloc(&sidecar->store, sizeof(*node));
+    if(!node)
+        return panic("failed to malloc store object");
+
+    node->id = id;
+    node->offset = offset;
+    node->length = length;
+    node->next = sidecar->root;
+    sidecar->root = node;
+    sidecar->count++;
+
+    return 0;
+}
+
+int sidecar_write(struct sidecar * sidecar, char * path) {
+    int status = 0;
+
+    FILE * file;
+    uint64_t i;
+    struct sidecar_header header;
+    struct sidecar_slot * slot;
+    struct sidecar_node * node;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SIDECAR_MAGIC, sizeof(SIDECAR_MAGIC));
+    header.count = sidecar->count;
+    header.data_size = sidecar->data_size;
+    header.data_mtime = sidecar->data_mtime;
+    header.size = 1;
+    while(header.size < header.count * 2)
+        header.size <<= 1;
+
+    slot = malloc(header.size * sizeof(*slot));
+    if(!slot) {
+        status = panic("out of memory");
+    } else {
+        for(i = 0; i < header.size; i++)
+            slot[i].id = -1;
+
+        node = sidecar->root;
+        while(node) {
+            i = sidecar_hash(node->id) & (header.size - 1);
+            while(slot[i].id != -1)
+                i = (i + 1) & (header.size - 1);
+            slot[i].id = node->id;
+            slot[i].offset = node->offset;
+            slot[i].length = node->length;
+            node = node->next;
+        }
+
+        file = fopen(path, "wb");
+        if(!file) {
+            status = panic("failed to open %s", path);
+        } else {
+            if( fwrite(&header, sizeof(header), 1, file) != 1 ||
+                fwrite(slot, sizeof(*slot), header.size, file) != header.size )
+                status = panic("failed to write %s", path);
+
+            if(fclose(file))
+                status = panic("failed to close %s", path);
+        }
+        free(slot);
+    }
+
+    return status;
+}
+
+int sidecar_stat(char * path, uint64_t * size, uint64_t * mtime) {
+    struct stat info;
+
+    if(stat(path, &info))
+        return 1;
+
+    *size = info.st_size;
+    *mtime = (uint64_t) info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+
+    return 0;
+}
+
+int sidecar_mmap(char * path, char ** data, size_t * size) {
+    int status = 0;
+
+    int fd;
+    struct stat info;
+
+    fd = open(path, O_RDONLY);
+    if(fd < 0) {
+        status = panic("failed to open %s", path);
+    } else {
+        if(fstat(fd, &info)) {
+            status = panic("failed to stat %s", path);
+        } else if(!info.st_size) {
+            *data = NULL;
+            *size = 0;
+        } else {
+            *data = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if(*data == MAP_FAILED) {
+                status = panic("failed to mmap %s", path);
+            } else {
+                *size = info.st_size;
+            }
+        }
+        close(fd);
+    }
+
+    return status;
+}
+
+int sidecar_map_open(struct sidecar_map * map, char * data, char * index) {
+    int status = 0;
+
+    if(sidecar_mmap(data, &map->data, &map->data_size)) {
+        status = panic("failed to mmap data");
+    } else if(!index) {
+        /* the data alone */
+        map->index = NULL;
+        map->index_size = 0;
+        map->header = NULL;
+        map->slot = NULL;
+    } else {
+        if(sidecar_mmap(index, &map->index, &map->index_size)) {
+            status = panic("failed to mmap index");
+        } else {
+            map->header = (void *) map->index;
+            map->slot = (void *) (map->header + 1);
+
+            if( map->index_size < sizeof(*map->header) ||
+                memcmp(map->header->magic, SIDECAR_MAGIC, sizeof(SIDECAR_MAGIC)) ||
+                !map->header->size ||
+                map->header->size & (map->header->size - 1) ||
+                map->index_size != sizeof(*map->header) + map->header->size * sizeof(*map->slot) )
+                status = panic("invalid index - %s", index);
+
+            if(status && map->index)
+                munmap(map->index, map->index_size);
+        }
+        if(status && map->data)
+            munmap(map->data, map->data_size);
+    }
+
+    return status;
+}
+
+void sidecar_map_close(struct sidecar_map * map) {
+    if(map->index)
+        munmap(map->index, map->index_size);
+    if(map->data)
+        munmap(map->data, map->data_size);
+}
+
+int sidecar_map_find(struct sidecar_map * map, long id, char ** string, size_t * length) {
+    uint64_t i;
+    uint64_t j;
+    uint64_t mask;
+    struct sidecar_slot * slot;
+
+    mask = map->header->size - 1;
+    i = sidecar_hash(id) & mask;
+    for(j = 0; j < map->header->size && map->slot[i].id != -1; j++) {
+        slot = &map->slot[i];
+        if(slot->id == id) {
+            if(slot->offset > map->data_size || slot->length > map->data_size - slot->offset)
+                return panic("invalid offset - %ld", id);
+            *string = map->data + slot->offset;
+            *length = slot->length;
+            return 0;
+        }
+        i = (i + 1) & mask;
+    }
+
+    return 1;
+}
+
+int sidecar_map_each(struct sidecar_map * map, long id, sidecar_map_cb cb, void * arg) {
+    uint64_t i;
+    uint64_t j;
+    uint64_t mask;
+    struct sidecar_slot * slot;
+
+    mask = map->header->size - 1;
+    i = sidecar_hash(id) & mask;
+    for(j = 0; j < map->header->size && map->slot[i].id != -1; j++) {
+        slot = &map->slot[i];
+        if(slot->id == id) {
+            if(slot->offset > map->data_size || slot->length > map->data_size - slot->offset)
+                return panic("invalid offset - %ld", id);
+            if(cb(map->data + slot->offset, slot->length, arg))
+                return panic("failed to process sidecar map object - %ld", id);
+        }
+        i = (i + 1) & mask;
+    }
+
+    return 0;
+}
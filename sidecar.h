@@ -0,0 +1,61 @@
+#ifndef sidecar_h
+#define sidecar_h
+
+#include <stdint.h>
+
+#include "store.h"
+
+#define SIDECAR_MAGIC "pj59idx"
+
+struct sidecar_header {
+    char magic[8];
+    uint64_t size;
+    uint64_t count;
+    uint64_t data_size;
+    uint64_t data_mtime;
+};
+
+struct sidecar_slot {
+    int64_t id;
+    uint64_t offset;
+    uint64_t length;
+};
+
+struct sidecar_node {
+    long id;
+    size_t offset;
+    size_t length;
+    struct sidecar_node * next;
+};
+
+struct sidecar {
+    struct store store;
+    struct sidecar_node * root;
+    size_t count;
+    uint64_t data_size;
+    uint64_t data_mtime;
+};
+
+int sidecar_create(struct sidecar *, size_t);
+void sidecar_destroy(struct sidecar *);
+int sidecar_add(struct sidecar *, long, size_t, size_t);
+int sidecar_write(struct sidecar *, char *);
+int sidecar_stat(char *, uint64_t *, uint64_t *);
+
+typedef int (* sidecar_map_cb) (char *, size_t, void *);
+
+struct sidecar_map {
+    char * data;
+    size_t data_size;
+    char * index;
+    size_t index_size;
+    struct sidecar_header * header;
+    struct sidecar_slot * slot;
+};
+
+int sidecar_map_open(struct sidecar_map *, char *, char *);
+void sidecar_map_close(struct sidecar_map *);
+int sidecar_map_find(struct sidecar_map *, long, char **, size_t *);
+int sidecar_map_each(struct sidecar_map *, long, sidecar_map_cb, void *);
+
+#endif
@@ -1,6 +1,7 @@
 #include "store.h"
 
 int store_alloc(struct store *);
+void * store_large(struct store *, size_t);
 
 int store_create(struct store * store, size_t size) {
     int status = 0;
@@ -11,6 +12,7 @@ int store_create(struct store * store, size_t size) {
         store->size = size;
         store->root = NULL;
         store->cache = NULL;
+        store->large = NULL;
     }
 
     return status;
@@ -37,6 +39,12 @@ void store_clear(struct store * store) {
         node->next = store->cache;
         store->cache = node;
     }
+
+    while(store->large) {
+        node = store->large;
+        store->large = store->large->next;
+        free(node);
+    }
 }
 
 int store_alloc(struct store * store) {
@@ -67,7 +75,9 @@ void * store_malloc(struct store * store, size_t size) {
     void * object = NULL;
 
     if(store->size < size) {
-        status = panic("invalid size");
+        object = store_large(store, size);
+        if(!object)
+            status = panic("failed to large store object");
     } else {
         if((!store->root || store->root->end - store->root->pos < size) && store_alloc(store)) {
             status = panic("out of memory");
@@ -80,6 +90,24 @@ void * store_malloc(struct store * store, size_t size) {
     return status ? NULL : object;
 }
 
+void * store_large(struct store * store, size_t size) {
+    struct store_node * node;
+
+    /* an object larger than a block gets a block of its own until the store is cleared */
+    node = malloc(sizeof(*node) + size);
+    if(!node) {
+        panic("out of memory");
+        return NULL;
+    }
+
+    node->pos = (void *) (node + 1);
+    node->end = node->pos + size;
+    node->next = store->large;
+    store->large = node;
+
+    return node->pos;
+}
+
 void * store_calloc(struct store * store, size_t size) {
     void * object;
 
@@ -102,6 +130,17 @@ char * store_strcpy(struct store * store, char * string, size_t length) {
     return buffer;
 }
 
+char * store_printf(struct store * store, char * format, ...) {
+    char * string;
+    va_list vararg;
+
+    va_start(vararg, format);
+    string = store_vprintf(store, format, vararg);
+    va_end(vararg);
+
+    return string;
+}
+
 char * store_vprintf(struct store * store, char * format, va_list vararg) {
     int status = 0;
 
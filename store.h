@@ -13,6 +13,7 @@ struct store {
     size_t size;
     struct store_node * root;
     struct store_node * cache;
+    struct store_node * large;
 };
 
 int store_create(struct store *, size_t);
@@ -21,6 +22,7 @@ void store_clear(struct store *);
 void * store_malloc(struct store *, size_t);
 void * store_calloc(struct store *, size_t);
 char * store_strcpy(struct store *, char *, size_t);
+char * store_printf(struct store *, char *, ...);
 char * store_vprintf(struct store *, char *, va_list);
 
 #endif
@@ -3,9 +3,17 @@
 int long_compare(void *, void *);
 int string_long(struct string *, long *);
 int string_store(struct string *, struct store *, char **);
+int string_script(struct string *, struct store *, char **);
 int string_strtol(char *, long *);
 int string_strcpy(char *, size_t, struct store *, char **);
 
+void table_lazy_create(struct table_lazy *, table_parse_cb);
+int table_lazy_defer(struct table_lazy *, char *);
+int table_lazy_load(struct table *, struct table_lazy *);
+
+int callfunc_scan(struct callfunc *, char *, size_t);
+int callfunc_add(struct callfunc *, char *, char *, size_t);
+
 struct tag_node skill_tag[] = {
     {1, tag_map, 0, NULL},
     {2, tag_list, 1, "Body"},
@@ -87,6 +95,19 @@ int string_store(struct string * string, struct store * store, char ** result) {
     return string_strcpy(string->string, string->length, store, result);
 }
 
+int string_script(struct string * string, struct store * store, char ** result) {
+    /* the second nul lets the scanner run on the script in place */
+    *result = store_malloc(store, string->length + 2);
+    if(!*result)
+        return panic("failed to malloc store object");
+
+    memcpy(*result, string->string, string->length);
+    (*result)[string->length] = 0;
+    (*result)[string->length + 1] = 0;
+
+    return 0;
+}
+
 int string_strtol(char * string, long * result) {
     char * last;
 
@@ -102,6 +123,9 @@ int string_strcpy(char * string, size_t length, struct store * store, char ** re
 }
 
 int item_create(struct item * item, size_t size, struct heap * heap) {
+    item->miss = NULL;
+    item->context = NULL;
+
     if(store_create(&item->store, size)) {
         panic("failed to create store object");
         goto store_fail;
@@ -188,15 +212,15 @@ int item_script_parse(struct item * item, char * string) {
 
                 switch(index) {
                     case 0:
-                        if(string_store(&script, &item->store, &item->item->bonus))
+                        if(string_script(&script, &item->store, &item->item->bonus))
                             return panic("failed to store string object");
                         break;
                     case 1:
-                        if(string_store(&script, &item->store, &item->item->equip))
+                        if(string_script(&script, &item->store, &item->item->equip))
                             return panic("failed to store string object");
                         break;
                     case 2:
-                        if(string_store(&script, &item->store, &item->item->unequip))
+                        if(string_script(&script, &item->store, &item->item->unequip))
                             return panic("failed to store string object");
                         break;
                 }
@@ -251,7 +275,7 @@ int item_combo_parse(enum csv_event type, int mark, struct string * string, void
             }
             break;
         case 2:
-            if(string_store(string, &item->store, &bonus))
+            if(string_script(string, &item->store, &bonus))
                 return panic("failed to store string object");
 
             string = strbuf_string(&item->strbuf);
@@ -428,6 +452,165 @@ int mercenary_parse(enum csv_event type, int mark, struct string * string, void
     return 0;
 }
 
+int callfunc_create(struct callfunc * callfunc, size_t size, struct heap * heap) {
+    int status = 0;
+
+    if(store_create(&callfunc->store, size)) {
+        status = panic("failed to create store object");
+    } else {
+        if(map_create(&callfunc->identifier, (map_compare_cb) strcmp, heap->map_pool))
+            status = panic("failed to create map object");
+        if(status)
+            store_destroy(&callfunc->store);
+    }
+
+    return status;
+}
+
+void callfunc_destroy(struct callfunc * callfunc) {
+    map_destroy(&callfunc->identifier);
+    store_destroy(&callfunc->store);
+}
+
+int callfunc_parse(struct callfunc * callfunc, char * path) {
+    int status = 0;
+
+    int length;
+    gzFile file;
+    char * buffer = NULL;
+    char * grow;
+    size_t size = 0;
+    size_t used = 0;
+
+    /* the function file is optional */
+    file = input_open(path);
+    if(!file)
+        return 0;
+
+    /* the file is read whole into a buffer that doubles as it fills */
+    length = 1;
+    while(length > 0 && !status) {
+        if(size - used < 4096) {
+            grow = realloc(buffer, size ? size * 2 : 65536);
+            if(!grow) {
+                status = panic("out of memory");
+            } else {
+                buffer = grow;
+                size = size ? size * 2 : 65536;
+            }
+        }
+
+        if(!status) {
+            length = input_read(file, buffer + used, size - used);
+            if(length > 0)
+                used += length;
+        }
+    }
+
+    if(status) {
+        /* skip */
+    } else if(length < 0) {
+        status = panic("failed to read %s", path);
+    } else if(callfunc_scan(callfunc, buffer, used)) {
+        status = panic("failed to scan callfunc object - %s", path);
+    }
+
+    free(buffer);
+    input_close(file);
+
+    return status;
+}
+
+int callfunc_scan(struct callfunc * callfunc, char * string, size_t length) {
+    int curly = 0;
+    int quote = 0;
+    char * anchor = NULL;
+    char * header = string;
+    char * end = string + length;
+
+    while(string < end) {
+        if(quote) {
+            if(*string == '\\' && string + 1 < end) {
+                string++;
+            } else if(*string == '"') {
+                quote = 0;
+            }
+        } else if(*string == '"') {
+            quote = 1;
+        } else if(*string == '/' && string + 1 < end && string[1] == '/') {
+            while(string + 1 < end && string[1] != '\n')
+                string++;
+        } else if(*string == '/' && string + 1 < end && string[1] == '*') {
+            string += 2;
+            while(string + 1 < end && !(string[0] == '*' && string[1] == '/'))
+                string++;
+        } else if(*string == '\n') {
+            if(!curly)
+                header = string + 1;
+        } else if(*string == '{') {
+            if(!curly)
+                anchor = string;
+            curly++;
+        } else if(*string == '}' && curly) {
+            curly--;
+            if(!curly) {
+                if(callfunc_add(callfunc, header, anchor, string - anchor + 1))
+                    return panic("failed to add callfunc object");
+                header = string + 1;
+            }
+        }
+        string++;
+    }
+
+    return 0;
+}
+
+int callfunc_add(struct callfunc * callfunc, char * header, char * block, size_t length) {
+    char * cursor;
+    struct callfunc_node * node;
+
+    /* function<tab>script<tab>name<tab>{ ... } */
+    while(header < block && isspace(*header))
+        header++;
+
+    if(block - header < 16 || strncmp(header, "function", 8) || !isspace(header[8]))
+        return 0;
+
+    header += 8;
+    while(header < block && isspace(*header))
+        header++;
+
+    if(block - header < 7 || strncmp(header, "script", 6) || !isspace(header[6]))
+        return 0;
+
+    header += 6;
+    while(header < block && isspace(*header))
+        header++;
+
+    cursor = header;
+    while(cursor < block && !isspace(*cursor))
+        cursor++;
+
+    if(cursor == header)
+        return 0;
+
+    node = store_calloc(&callfunc->store, sizeof(*node));
+    if(!node)
+        return panic("failed to calloc store object");
+
+    if(string_strcpy(header, cursor - header, &callfunc->store, &node->identifier))
+        return panic("failed to strcpy string object");
+
+    if(string_strcpy(block, length, &callfunc->store, &node->script))
+        return panic("failed to strcpy string object");
+
+    /* a later definition replaces an earlier one */
+    if(map_insert(&callfunc->identifier, node->identifier, node))
+        return panic("failed to insert map object");
+
+    return 0;
+}
+
 int constant_create(struct constant * constant, size_t size, struct heap * heap) {
     int status = 0;
 
@@ -817,80 +1000,159 @@ int argument_entry_create(struct argument * argument, char * string, size_t leng
     return status;
 }
 
-int table_create(struct table * table, size_t size, struct heap * heap) {
-    if(yaml_create(&table->yaml, 64, size)) {
-        panic("failed to create yaml object");
-        goto yaml_fail;
-    } else if(item_create(&table->item, size, heap)) {
-        panic("failed to create item object");
-        goto item_fail;
-    } else if(skill_create(&table->skill, size, heap)) {
-        panic("failed to create skill object");
-        goto skill_fail;
-    } else if(mob_create(&table->mob, size, heap)) {
-        panic("failed to create mob object");
-        goto mob_fail;
-    } else if(mercenary_create(&table->mercenary, size, heap)) {
-        panic("failed to create mercenary object");
-        goto mercenary_fail;
-    } else if(constant_create(&table->constant, size, heap)) {
-        panic("failed to create constant object");
-        goto constant_fail;
-    } else if(argument_create(&table->argument, size, heap)) {
+int locale_create(struct locale * locale, size_t size, struct heap * heap) {
+    if(store_create(&locale->store, size)) {
+        panic("failed to create store object");
+        goto store_fail;
+    } else if(map_create(&locale->tag, (map_compare_cb) strcmp, heap->map_pool)) {
+        panic("failed to create map object");
+        goto tag_fail;
+    } else if(argument_create(&locale->argument, size, heap)) {
         panic("failed to create argument object");
         goto argument_fail;
-    } else if(argument_create(&table->bonus, size, heap)) {
+    } else if(argument_create(&locale->bonus, size, heap)) {
         panic("failed to create argument object");
         goto bonus_fail;
-    } else if(argument_create(&table->bonus2, size, heap)) {
+    } else if(argument_create(&locale->bonus2, size, heap)) {
         panic("failed to create argument object");
         goto bonus2_fail;
-    } else if(argument_create(&table->bonus3, size, heap)) {
+    } else if(argument_create(&locale->bonus3, size, heap)) {
         panic("failed to create argument object");
         goto bonus3_fail;
-    } else if(argument_create(&table->bonus4, size, heap)) {
+    } else if(argument_create(&locale->bonus4, size, heap)) {
         panic("failed to create argument object");
         goto bonus4_fail;
-    } else if(argument_create(&table->bonus5, size, heap)) {
+    } else if(argument_create(&locale->bonus5, size, heap)) {
         panic("failed to create argument object");
         goto bonus5_fail;
-    } else if(argument_create(&table->sc_start, size, heap)) {
+    } else if(argument_create(&locale->sc_start, size, heap)) {
         panic("failed to create argument object");
         goto sc_start_fail;
-    } else if(argument_create(&table->sc_start2, size, heap)) {
+    } else if(argument_create(&locale->sc_start2, size, heap)) {
         panic("failed to create argument object");
         goto sc_start2_fail;
-    } else if(argument_create(&table->sc_start4, size, heap)) {
+    } else if(argument_create(&locale->sc_start4, size, heap)) {
         panic("failed to create argument object");
         goto sc_start4_fail;
-    } else if(argument_create(&table->statement, size, heap)) {
+    } else if(argument_create(&locale->statement, size, heap)) {
         panic("failed to create argument object");
         goto statement_fail;
     }
 
+    locale->identifier = NULL;
+
     return 0;
 
 statement_fail:
-    argument_destroy(&table->sc_start4);
+    argument_destroy(&locale->sc_start4);
 sc_start4_fail:
-    argument_destroy(&table->sc_start2);
+    argument_destroy(&locale->sc_start2);
 sc_start2_fail:
-    argument_destroy(&table->sc_start);
+    argument_destroy(&locale->sc_start);
 sc_start_fail:
-    argument_destroy(&table->bonus5);
+    argument_destroy(&locale->bonus5);
 bonus5_fail:
-    argument_destroy(&table->bonus4);
+    argument_destroy(&locale->bonus4);
 bonus4_fail:
-    argument_destroy(&table->bonus3);
+    argument_destroy(&locale->bonus3);
 bonus3_fail:
-    argument_destroy(&table->bonus2);
+    argument_destroy(&locale->bonus2);
 bonus2_fail:
-    argument_destroy(&table->bonus);
+    argument_destroy(&locale->bonus);
 bonus_fail:
-    argument_destroy(&table->argument);
+    argument_destroy(&locale->argument);
 argument_fail:
+    map_destroy(&locale->tag);
+tag_fail:
+    store_destroy(&locale->store);
+store_fail:
+    return 1;
+}
+
+void locale_destroy(struct locale * locale) {
+    argument_destroy(&locale->statement);
+    argument_destroy(&locale->sc_start4);
+    argument_destroy(&locale->sc_start2);
+    argument_destroy(&locale->sc_start);
+    argument_destroy(&locale->bonus5);
+    argument_destroy(&locale->bonus4);
+    argument_destroy(&locale->bonus3);
+    argument_destroy(&locale->bonus2);
+    argument_destroy(&locale->bonus);
+    argument_destroy(&locale->argument);
+    map_destroy(&locale->tag);
+    store_destroy(&locale->store);
+}
+
+int locale_tag_parse(enum yaml_event event, int mark, char * string, size_t length, void * context) {
+    char * tag;
+    struct locale * locale = context;
+
+    switch(mark) {
+        case 1:
+            if(event == yaml_map_start)
+                locale->identifier = NULL;
+            break;
+        case 2: return string_strcpy(string, length, &locale->store, &locale->identifier); break;
+        case 4:
+            if(!locale->identifier) {
+                return panic("invalid string object");
+            } else if(string_strcpy(string, length, &locale->store, &tag)) {
+                return panic("failed to strcpy string object");
+            } else if(map_insert(&locale->tag, locale->identifier, tag)) {
+                return panic("failed to insert map object");
+            }
+            break;
+    }
+
+    return 0;
+}
+
+int table_create(struct table * table, size_t size, struct heap * heap) {
+    if(yaml_create(&table->yaml, 64, size)) {
+        panic("failed to create yaml object");
+        goto yaml_fail;
+    } else if(item_create(&table->item, size, heap)) {
+        panic("failed to create item object");
+        goto item_fail;
+    } else if(skill_create(&table->skill, size, heap)) {
+        panic("failed to create skill object");
+        goto skill_fail;
+    } else if(mob_create(&table->mob, size, heap)) {
+        panic("failed to create mob object");
+        goto mob_fail;
+    } else if(mercenary_create(&table->mercenary, size, heap)) {
+        panic("failed to create mercenary object");
+        goto mercenary_fail;
+    } else if(callfunc_create(&table->callfunc, size, heap)) {
+        panic("failed to create callfunc object");
+        goto callfunc_fail;
+    } else if(constant_create(&table->constant, size, heap)) {
+        panic("failed to create constant object");
+        goto constant_fail;
+    } else if(locale_create(&table->locale[0], size, heap)) {
+        panic("failed to create locale object");
+        goto locale_fail;
+    } else if(pthread_mutex_init(&table->mutex, NULL)) {
+        panic("failed to create mutex");
+        goto mutex_fail;
+    }
+
+    table->current = &table->locale[0];
+    table->count = 1;
+    table_lazy_create(&table->skill_lazy, table_skill_parse);
+    table_lazy_create(&table->mob_lazy, table_mob_parse);
+    table_lazy_create(&table->mercenary_lazy, table_mercenary_parse);
+
+    return 0;
+
+mutex_fail:
+    locale_destroy(&table->locale[0]);
+locale_fail:
     constant_destroy(&table->constant);
 constant_fail:
+    callfunc_destroy(&table->callfunc);
+callfunc_fail:
     mercenary_destroy(&table->mercenary);
 mercenary_fail:
     mob_destroy(&table->mob);
@@ -905,17 +1167,14 @@ yaml_fail:
 }
 
 void table_destroy(struct table * table) {
-    argument_destroy(&table->statement);
-    argument_destroy(&table->sc_start4);
-    argument_destroy(&table->sc_start2);
-    argument_destroy(&table->sc_start);
-    argument_destroy(&table->bonus5);
-    argument_destroy(&table->bonus4);
-    argument_destroy(&table->bonus3);
-    argument_destroy(&table->bonus2);
-    argument_destroy(&table->bonus);
-    argument_destroy(&table->argument);
+    free(table->mercenary_lazy.path);
+    free(table->mob_lazy.path);
+    free(table->skill_lazy.path);
+    pthread_mutex_destroy(&table->mutex);
+    while(table->count > 0)
+        locale_destroy(&table->locale[--table->count]);
     constant_destroy(&table->constant);
+    callfunc_destroy(&table->callfunc);
     mercenary_destroy(&table->mercenary);
     mob_destroy(&table->mob);
     skill_destroy(&table->skill);
@@ -923,6 +1182,111 @@ void table_destroy(struct table * table) {
     yaml_destroy(&table->yaml);
 }
 
+void table_lazy_create(struct table_lazy * lazy, table_parse_cb parse) {
+    atomic_init(&lazy->done, 1);
+    lazy->status = 0;
+    lazy->path = NULL;
+    lazy->parse = parse;
+}
+
+int table_lazy_defer(struct table_lazy * lazy, char * path) {
+    size_t length;
+
+    length = strlen(path);
+    lazy->path = malloc(length + 1);
+    if(!lazy->path)
+        return panic("out of memory");
+
+    memcpy(lazy->path, path, length + 1);
+    atomic_store(&lazy->done, 0);
+
+    return 0;
+}
+
+int table_lazy_load(struct table * table, struct table_lazy * lazy) {
+    if(atomic_load_explicit(&lazy->done, memory_order_acquire))
+        return lazy->status;
+
+    /* one load at a time since the tables share the heap */
+    pthread_mutex_lock(&table->mutex);
+    if(!atomic_load_explicit(&lazy->done, memory_order_relaxed)) {
+        if(lazy->parse(table, lazy->path))
+            lazy->status = panic("failed to parse table object - %s", lazy->path);
+        atomic_store_explicit(&lazy->done, 1, memory_order_release);
+    }
+    pthread_mutex_unlock(&table->mutex);
+
+    return lazy->status;
+}
+
+int table_locale_create(struct table * table, size_t size, struct heap * heap) {
+    if(table->count >= LOCALE_MAX) {
+        return panic("out of locale");
+    } else if(locale_create(&table->locale[table->count], size, heap)) {
+        return panic("failed to create locale object");
+    }
+
+    table->current = &table->locale[table->count++];
+
+    return 0;
+}
+
+int table_locale_set(struct table * table, size_t index) {
+    if(index >= table->count)
+        return panic("invalid locale - %zu", index);
+
+    table->current = &table->locale[index];
+
+    return 0;
+}
+
+int table_locale_parse(struct table * table, struct strbuf * strbuf, char * path) {
+    int status = 0;
+
+    static char * file[] = {
+        "argument.yml",
+        "bonus.yml",
+        "bonus2.yml",
+        "bonus3.yml",
+        "bonus4.yml",
+        "bonus5.yml",
+        "sc_start.yml",
+        "sc_start2.yml",
+        "sc_start4.yml",
+        "statement.yml",
+        NULL
+    };
+
+    static table_parse_cb parse[] = {
+        table_argument_parse,
+        table_bonus_parse,
+        table_bonus2_parse,
+        table_bonus3_parse,
+        table_bonus4_parse,
+        table_bonus5_parse,
+        table_sc_start_parse,
+        table_sc_start2_parse,
+        table_sc_start4_parse,
+        table_statement_parse
+    };
+
+    size_t i;
+    char * string;
+
+    for(i = 0; file[i] && !status; i++) {
+        strbuf_clear(strbuf);
+        if(strbuf_printf(strbuf, "%s/%s", path, file[i])) {
+            status = panic("failed to printf strbuf object");
+        } else if(!(string = strbuf_array(strbuf))) {
+            status = panic("failed to array strbuf object");
+        } else if(parse[i](table, string)) {
+            status = panic("failed to parse table object - %s", string);
+        }
+    }
+
+    return status;
+}
+
 int table_item_parse(struct table * table, char * path) {
     return csv_parse(path, item_parse, &table->item);
 }
@@ -931,6 +1295,14 @@ int table_item_combo_parse(struct table * table, char * path) {
     return csv_parse(path, item_combo_parse, &table->item);
 }
 
+int table_item_bytes_parse(struct table * table, char * string, size_t length) {
+    return csv_parse_bytes(string, length, item_parse, &table->item);
+}
+
+int table_item_combo_bytes_parse(struct table * table, char * string, size_t length) {
+    return csv_parse_bytes(string, length, item_combo_parse, &table->item);
+}
+
 int table_skill_parse(struct table * table, char * path) {
     return yaml_parse(&table->yaml, skill_tag, path, skill_parse, &table->skill);
 }
@@ -943,6 +1315,22 @@ int table_mercenary_parse(struct table * table, char * path) {
     return csv_parse(path, mercenary_parse, &table->mercenary);
 }
 
+int table_skill_defer(struct table * table, char * path) {
+    return table_lazy_defer(&table->skill_lazy, path);
+}
+
+int table_mob_defer(struct table * table, char * path) {
+    return table_lazy_defer(&table->mob_lazy, path);
+}
+
+int table_mercenary_defer(struct table * table, char * path) {
+    return table_lazy_defer(&table->mercenary_lazy, path);
+}
+
+int table_callfunc_parse(struct table * table, char * path) {
+    return callfunc_parse(&table->callfunc, path);
+}
+
 int table_constant_parse(struct table * table, char * path) {
     return yaml_parse(&table->yaml, constant_tag, path, constant_parse, &table->constant);
 }
@@ -955,44 +1343,48 @@ int table_constant_group_parse(struct table * table, char * path) {
     return yaml_parse(&table->yaml, constant_group_tag, path, constant_group_parse, &table->constant);
 }
 
+int table_constant_tag_parse(struct table * table, char * path) {
+    return yaml_parse(&table->yaml, constant_tag, path, locale_tag_parse, table->current);
+}
+
 int table_argument_parse(struct table * table, char * path) {
-    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->argument);
+    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->current->argument);
 }
 
 int table_bonus_parse(struct table * table, char * path) {
-    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->bonus);
+    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->current->bonus);
 }
 
 int table_bonus2_parse(struct table * table, char * path) {
-    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->bonus2);
+    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->current->bonus2);
 }
 
 int table_bonus3_parse(struct table * table, char * path) {
-    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->bonus3);
+    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->current->bonus3);
 }
 
 int table_bonus4_parse(struct table * table, char * path) {
-    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->bonus4);
+    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->current->bonus4);
 }
 
 int table_bonus5_parse(struct table * table, char * path) {
-    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->bonus5);
+    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->current->bonus5);
 }
 
 int table_sc_start_parse(struct table * table, char * path) {
-    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->sc_start);
+    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->current->sc_start);
 }
 
 int table_sc_start2_parse(struct table * table, char * path) {
-    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->sc_start2);
+    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->current->sc_start2);
 }
 
 int table_sc_start4_parse(struct table * table, char * path) {
-    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->sc_start4);
+    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->current->sc_start4);
 }
 
 int table_statement_parse(struct table * table, char * path) {
-    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->statement);
+    return yaml_parse(&table->yaml, argument_tag, path, argument_parse, &table->current->statement);
 }
 
 struct item_node * item_start(struct table * table) {
@@ -1004,33 +1396,73 @@ struct item_node * item_next(struct table * table) {
 }
 
 struct item_node * item_id(struct table * table, long id) {
-    return map_search(&table->item.id, &id);
+    struct item_node * item;
+
+    item = map_search(&table->item.id, &id);
+    if(!item && table->item.miss && !table->item.miss(table->item.context, id, NULL))
+        item = map_search(&table->item.id, &id);
+
+    return item;
 }
 
 struct item_node * item_name(struct table * table, char * name) {
-    return map_search(&table->item.name, name);
+    struct item_node * item;
+
+    item = map_search(&table->item.name, name);
+    if(!item && table->item.miss && !table->item.miss(table->item.context, 0, name))
+        item = map_search(&table->item.name, name);
+
+    return item;
+}
+
+struct item_node * item_id_lower(struct table * table, long id) {
+    return map_lower(&table->item.id, &id).value;
+}
+
+void item_miss(struct table * table, item_miss_cb miss, void * context) {
+    table->item.miss = miss;
+    table->item.context = context;
 }
 
 struct skill_node * skill_id(struct table * table, long id) {
+    if(table_lazy_load(table, &table->skill_lazy))
+        return NULL;
+
     return map_search(&table->skill.id, &id);
 }
 
 struct skill_node * skill_name(struct table * table, char * name) {
+    if(table_lazy_load(table, &table->skill_lazy))
+        return NULL;
+
     return map_search(&table->skill.name, name);
 }
 
 struct mob_node * mob_id(struct table * table, long id) {
+    if(table_lazy_load(table, &table->mob_lazy))
+        return NULL;
+
     return map_search(&table->mob.id, &id);
 }
 
 struct mob_node * mob_sprite(struct table * table, char * sprite) {
+    if(table_lazy_load(table, &table->mob_lazy))
+        return NULL;
+
     return map_search(&table->mob.sprite, sprite);
 }
 
 struct mercenary_node * mercenary_id(struct table * table, long id) {
+    if(table_lazy_load(table, &table->mercenary_lazy))
+        return NULL;
+
     return map_search(&table->mercenary.id, &id);
 }
 
+struct callfunc_node * callfunc_identifier(struct table * table, char * identifier) {
+    return map_search(&table->callfunc.identifier, identifier);
+}
+
 struct constant_node * constant_identifier(struct table * table, char * identifier) {
     return map_search(&table->constant.identifier, identifier);
 }
@@ -1039,42 +1471,50 @@ struct constant_group_node * constant_group_identifier(struct table * table, cha
     return map_search(&table->constant.group, identifier);
 }
 
+char * locale_tag(struct table * table, struct constant_node * constant) {
+    char * tag;
+
+    tag = map_search(&table->current->tag, constant->identifier);
+
+    return tag ? tag : constant->tag;
+}
+
 struct argument_node * argument_identifier(struct table * table, char * identifier) {
-    return map_search(&table->argument.identifier, identifier);
+    return map_search(&table->current->argument.identifier, identifier);
 }
 
 struct argument_node * bonus_identifier(struct table * table, char * identifier) {
-    return map_search(&table->bonus.identifier, identifier);
+    return map_search(&table->current->bonus.identifier, identifier);
 }
 
 struct argument_node * bonus2_identifier(struct table * table, char * identifier) {
-    return map_search(&table->bonus2.identifier, identifier);
+    return map_search(&table->current->bonus2.identifier, identifier);
 }
 
 struct argument_node * bonus3_identifier(struct table * table, char * identifier) {
-    return map_search(&table->bonus3.identifier, identifier);
+    return map_search(&table->current->bonus3.identifier, identifier);
 }
 
 struct argument_node * bonus4_identifier(struct table * table, char * identifier) {
-    return map_search(&table->bonus4.identifier, identifier);
+    return map_search(&table->current->bonus4.identifier, identifier);
 }
 
 struct argument_node * bonus5_identifier(struct table * table, char * identifier) {
-    return map_search(&table->bonus5.identifier, identifier);
+    return map_search(&table->current->bonus5.identifier, identifier);
 }
 
 struct argument_node * sc_start_identifier(struct table * table, char * identifier) {
-    return map_search(&table->sc_start.identifier, identifier);
+    return map_search(&table->current->sc_start.identifier, identifier);
 }
 
 struct argument_node * sc_start2_identifier(struct table * table, char * identifier) {
-    return map_search(&table->sc_start2.identifier, identifier);
+    return map_search(&table->current->sc_start2.identifier, identifier);
 }
 
 struct argument_node * sc_start4_identifier(struct table * table, char * identifier) {
-    return map_search(&table->sc_start4.identifier, identifier);
+    return map_search(&table->current->sc_start4.identifier, identifier);
 }
 
 struct argument_node * statement_identifier(struct table * table, char * identifier) {
-    return map_search(&table->statement.identifier, identifier);
+    return map_search(&table->current->statement.identifier, identifier);
 }
@@ -1,6 +1,9 @@
 #ifndef table_h
 #define table_h
 
+#include <pthread.h>
+#include <stdatomic.h>
+
 #include "heap.h"
 #include "csv.h"
 #include "yaml.h"
@@ -20,7 +23,11 @@ struct item_node {
     struct item_combo_node * combo;
 };
 
+typedef int (* item_miss_cb) (void *, long, char *);
+
 struct item {
+    item_miss_cb miss;
+    void * context;
     struct store store;
     struct stack stack;
     struct strbuf strbuf;
@@ -85,6 +92,20 @@ int mercenary_create(struct mercenary *, size_t, struct heap *);
 void mercenary_destroy(struct mercenary *);
 int mercenary_parse(enum csv_event, int, struct string *, void *);
 
+struct callfunc_node {
+    char * identifier;
+    char * script;
+};
+
+struct callfunc {
+    struct store store;
+    struct map identifier;
+};
+
+int callfunc_create(struct callfunc *, size_t, struct heap *);
+void callfunc_destroy(struct callfunc *);
+int callfunc_parse(struct callfunc *, char *);
+
 struct constant_node {
     char * identifier;
     long value;
@@ -119,6 +140,8 @@ int constant_group_parse(enum yaml_event, int, char *, size_t, void *);
 struct optional_node {
     long index;
     char * string;
+    struct script_node * root;
+    struct script_code * code;
     struct optional_node * next;
 };
 
@@ -147,18 +170,26 @@ struct print_node {
 
 #define ENTRY_MAX 16
 
+struct script;
+struct argument_node;
+
+typedef int (* argument_cb) (struct script *, struct stack *, struct argument_node *, struct strbuf *);
+
 struct entry_node {
     long array[ENTRY_MAX];
     size_t count;
     char * identifier;
     size_t length;
     char * string;
+    argument_cb callback;
+    struct argument_node * argument;
     struct entry_node * next;
 };
 
 struct argument_node {
     char * identifier;
     char * handler;
+    argument_cb callback;
     struct print_node * print;
     struct range_node * range;
     struct map * map;
@@ -185,13 +216,12 @@ int argument_parse(enum yaml_event, int, char *, size_t, void *);
 int argument_entry_parse(struct argument *, char *, size_t);
 int argument_entry_create(struct argument *, char *, size_t);
 
-struct table {
-    struct yaml yaml;
-    struct item item;
-    struct skill skill;
-    struct mob mob;
-    struct mercenary mercenary;
-    struct constant constant;
+#define LOCALE_MAX 8
+
+struct locale {
+    struct store store;
+    struct map tag;
+    char * identifier;
     struct argument argument;
     struct argument bonus;
     struct argument bonus2;
@@ -204,16 +234,58 @@ struct table {
     struct argument statement;
 };
 
+int locale_create(struct locale *, size_t, struct heap *);
+void locale_destroy(struct locale *);
+int locale_tag_parse(enum yaml_event, int, char *, size_t, void *);
+
+struct table;
+
+typedef int (* table_parse_cb) (struct table *, char *);
+
+struct table_lazy {
+    atomic_int done;
+    int status;
+    char * path;
+    table_parse_cb parse;
+};
+
+struct table {
+    struct yaml yaml;
+    struct item item;
+    struct skill skill;
+    struct mob mob;
+    struct mercenary mercenary;
+    struct callfunc callfunc;
+    struct constant constant;
+    struct locale locale[LOCALE_MAX];
+    struct locale * current;
+    size_t count;
+    pthread_mutex_t mutex;
+    struct table_lazy skill_lazy;
+    struct table_lazy mob_lazy;
+    struct table_lazy mercenary_lazy;
+};
+
 int table_create(struct table *, size_t, struct heap *);
 void table_destroy(struct table *);
+int table_locale_create(struct table *, size_t, struct heap *);
+int table_locale_set(struct table *, size_t);
+int table_locale_parse(struct table *, struct strbuf *, char *);
 int table_item_parse(struct table *, char *);
 int table_item_combo_parse(struct table *, char *);
+int table_item_bytes_parse(struct table *, char *, size_t);
+int table_item_combo_bytes_parse(struct table *, char *, size_t);
 int table_skill_parse(struct table *, char *);
 int table_mob_parse(struct table *, char *);
 int table_mercenary_parse(struct table *, char *);
+int table_skill_defer(struct table *, char *);
+int table_mob_defer(struct table *, char *);
+int table_mercenary_defer(struct table *, char *);
+int table_callfunc_parse(struct table *, char *);
 int table_constant_parse(struct table *, char *);
 int table_constant_data_parse(struct table *, char *);
 int table_constant_group_parse(struct table *, char *);
+int table_constant_tag_parse(struct table *, char *);
 int table_argument_parse(struct table *, char *);
 int table_bonus_parse(struct table *, char *);
 int table_bonus2_parse(struct table *, char *);
@@ -229,6 +301,8 @@ struct item_node * item_start(struct table *);
 struct item_node * item_next(struct table *);
 struct item_node * item_id(struct table *, long);
 struct item_node * item_name(struct table *, char *);
+struct item_node * item_id_lower(struct table *, long);
+void item_miss(struct table *, item_miss_cb, void *);
 
 struct skill_node * skill_id(struct table *, long);
 struct skill_node * skill_name(struct table *, char *);
@@ -238,8 +312,11 @@ struct mob_node * mob_sprite(struct table *, char *);
 
 struct mercenary_node * mercenary_id(struct table *, long);
 
+struct callfunc_node * callfunc_identifier(struct table *, char *);
+
 struct constant_node * constant_identifier(struct table *, char *);
 struct constant_group_node * constant_group_identifier(struct table *, char *);
+char * locale_tag(struct table *, struct constant_node *);
 struct argument_node * argument_identifier(struct table *, char *);
 struct argument_node * bonus_identifier(struct table *, char *);
 struct argument_node * bonus2_identifier(struct table *, char *);
@@ -0,0 +1,76 @@
+#!/bin/sh
+# usage: test/run.sh [pj59]
+#
+# builds a data directory from the tables in the repository and the
+# databases in test/data and checks the output of each case
+
+root=$(cd "$(dirname "$0")/.." && pwd)
+pj59=${1:-$root/pj59}
+data=$(mktemp -d)
+output=$(mktemp)
+render=$(mktemp)
+status=0
+
+trap 'rm -rf "$data" "$output" "$render"' EXIT
+
+cp "$root"/*.yml "$root"/test/data/* "$data"
+
+# usage: check <name> <expected> <command>...
+check() {
+    name=$1
+    expected=$2
+    shift 2
+    if ! "$@" > "$output" 2> /dev/null; then
+        echo "fail: $name (exit)"
+        status=1
+    elif ! diff -u "$root/test/$expected.out" "$output"; then
+        echo "fail: $name"
+        status=1
+    else
+        echo "pass: $name"
+    fi
+}
+
+# usage: same <name> <argument>...
+same() {
+    name=$1
+    shift
+    if ! "$pj59" "$@" > "$output" 2> /dev/null || ! "$pj59" -g "$@" > "$render" 2> /dev/null; then
+        echo "fail: $name (exit)"
+        status=1
+    elif ! diff -u "$output" "$render"; then
+        echo "fail: $name"
+        status=1
+    else
+        echo "pass: $name"
+    fi
+}
+
+# usage: npc <file>
+npc() {
+    rm -rf "$data/npc"
+    "$pj59" -N "$root/test/npc" -o "$data/npc" -j 1 "$data" && cat "$data/npc/$1.txt.yml"
+}
+
+# a literal that decides a condition is not filled into a shared plan
+check shape shape "$pj59" -i 2001-2008 "$data"
+check shape-cache shape "$pj59" -s -i 2001-2008 "$data"
+
+# a list or a block that does not fit in a strbuf is summarised or cut short
+check budget budget "$pj59" -i 3301-3302 "$data"
+
+# a function file larger than a strbuf is read whole
+check callfunc callfunc "$pj59" -i 2201 "$data"
+
+# the loop steps and default arguments run as compiled instructions give what the tree walk gave
+check code code "$pj59" -i 4001-4012 "$data"
+
+# the generated templates write what the interpreted templates write
+check render render "$pj59" -i 2301 "$data"
+check render-generated render "$pj59" -g -i 2301 "$data"
+same render-all "$data"
+
+# a script that fails to scan leaves the scanner and the parser ready for the next
+check scan scan npc scan
+
+exit $status
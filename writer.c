@@ -0,0 +1,249 @@
+#include "writer.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+int writer_map(struct writer *);
+int writer_unmap(struct writer *);
+int writer_output(struct writer *, char *, size_t);
+int writer_compress_create(struct writer *);
+void writer_compress_destroy(struct writer *);
+int writer_compress(struct writer *, char *, size_t, int);
+
+int writer_open(struct writer * writer, char * path, int level) {
+    int status = 0;
+
+    struct stat info;
+
+    writer->map = NULL;
+    writer->base = 0;
+    writer->size = 0;
+    writer->offset = 0;
+    writer->level = level;
+    writer->deflate = NULL;
+
+    if(!path) {
+        writer->fd = STDOUT_FILENO;
+    } else {
+        writer->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if(writer->fd < 0) {
+            status = panic("failed to open %s", path);
+        } else if(fstat(writer->fd, &info)) {
+            status = panic("failed to stat %s", path);
+            close(writer->fd);
+        } else if(S_ISREG(info.st_mode)) {
+            writer->size = WRITER_CHUNK;
+        }
+    }
+
+    if(status) {
+        /* skip */
+    } else if(level && writer_compress_create(writer)) {
+        status = panic("failed to create compress stream");
+        if(writer->fd != STDOUT_FILENO)
+            close(writer->fd);
+    }
+
+    return status;
+}
+
+int writer_close(struct writer * writer) {
+    int status = 0;
+
+    if(writer->fd < 0)
+        return 0;
+
+    if(writer->level) {
+        if(writer_compress(writer, NULL, 0, 1))
+            status = panic("failed to finish compress stream");
+        writer_compress_destroy(writer);
+    }
+
+    if(writer->size) {
+        if(writer_unmap(writer)) {
+            status = panic("failed to unmap writer object");
+        } else if(ftruncate(writer->fd, writer->offset)) {
+            status = panic("failed to truncate file");
+        }
+    }
+
+    if(writer->fd != STDOUT_FILENO && close(writer->fd))
+        status = panic("failed to close file");
+
+    writer->fd = -1;
+
+    return status;
+}
+
+int writer_map(struct writer * writer) {
+    if(ftruncate(writer->fd, writer->base + writer->size))
+        return panic("failed to truncate file");
+
+    writer->map = mmap(NULL, writer->size, PROT_READ | PROT_WRITE, MAP_SHARED, writer->fd, writer->base);
+    if(writer->map == MAP_FAILED) {
+        writer->map = NULL;
+        return panic("failed to mmap file");
+    }
+
+    return 0;
+}
+
+int writer_unmap(struct writer * writer) {
+    if(writer->map) {
+        if(munmap(writer->map, writer->size))
+            return panic("failed to munmap file");
+        writer->map = NULL;
+    }
+
+    return 0;
+}
+
+int writer_write(struct writer * writer, char * buffer, size_t length) {
+    if(writer->level)
+        return writer_compress(writer, buffer, length, 0);
+
+    return writer_output(writer, buffer, length);
+}
+
+int writer_output(struct writer * writer, char * buffer, size_t length) {
+    ssize_t result;
+    size_t size;
+
+    while(length) {
+        if(writer->size) {
+            if(writer->offset == writer->base + writer->size) {
+                if(writer_unmap(writer))
+                    return panic("failed to unmap writer object");
+                writer->base += writer->size;
+            }
+
+            if(!writer->map && writer_map(writer))
+                return panic("failed to map writer object");
+
+            size = writer->base + writer->size - writer->offset;
+            if(size > length)
+                size = length;
+
+            memcpy(writer->map + (writer->offset - writer->base), buffer, size);
+            result = size;
+        } else {
+            result = write(writer->fd, buffer, length);
+            if(result < 0) {
+                if(errno == EINTR)
+                    continue;
+                return panic("failed to write file");
+            }
+        }
+
+        writer->offset += result;
+        buffer += result;
+        length -= result;
+    }
+
+    return 0;
+}
+
+#ifdef WRITER_ZSTD
+int writer_compress_create(struct writer * writer) {
+    int status = 0;
+
+    writer->deflate = malloc(WRITER_DEFLATE);
+    if(!writer->deflate) {
+        status = panic("out of memory");
+    } else {
+        writer->stream = ZSTD_createCCtx();
+        if(!writer->stream) {
+            status = panic("failed to create zstd context");
+        } else if(ZSTD_isError(ZSTD_CCtx_setParameter(writer->stream, ZSTD_c_compressionLevel, writer->level))) {
+            status = panic("invalid level - %d", writer->level);
+        } else {
+            return status;
+        }
+
+        if(writer->stream)
+            ZSTD_freeCCtx(writer->stream);
+        free(writer->deflate);
+        writer->deflate = NULL;
+    }
+
+    return status;
+}
+
+void writer_compress_destroy(struct writer * writer) {
+    ZSTD_freeCCtx(writer->stream);
+    free(writer->deflate);
+    writer->deflate = NULL;
+    writer->level = 0;
+}
+
+int writer_compress(struct writer * writer, char * buffer, size_t length, int finish) {
+    size_t result;
+    ZSTD_inBuffer input = { buffer, length, 0 };
+    ZSTD_outBuffer output;
+
+    do {
+        output.dst = writer->deflate;
+        output.size = WRITER_DEFLATE;
+        output.pos = 0;
+
+        result = ZSTD_compressStream2(writer->stream, &output, &input, finish ? ZSTD_e_end : ZSTD_e_continue);
+        if(ZSTD_isError(result))
+            return panic("failed to compress - %s", ZSTD_getErrorName(result));
+
+        if(output.pos && writer_output(writer, writer->deflate, output.pos))
+            return panic("failed to output writer object");
+    } while(finish ? result : input.pos < input.size);
+
+    return 0;
+}
+#else
+int writer_compress_create(struct writer * writer) {
+    int status = 0;
+
+    writer->deflate = malloc(WRITER_DEFLATE);
+    if(!writer->deflate) {
+        status = panic("out of memory");
+    } else {
+        memset(&writer->stream, 0, sizeof(writer->stream));
+        /* gzip header and trailer */
+        if(deflateInit2(&writer->stream, writer->level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            status = panic("invalid level - %d", writer->level);
+            free(writer->deflate);
+            writer->deflate = NULL;
+        }
+    }
+
+    return status;
+}
+
+void writer_compress_destroy(struct writer * writer) {
+    deflateEnd(&writer->stream);
+    free(writer->deflate);
+    writer->deflate = NULL;
+    writer->level = 0;
+}
+
+int writer_compress(struct writer * writer, char * buffer, size_t length, int finish) {
+    int result;
+
+    writer->stream.next_in = (unsigned char *) buffer;
+    writer->stream.avail_in = length;
+
+    do {
+        writer->stream.next_out = (unsigned char *) writer->deflate;
+        writer->stream.avail_out = WRITER_DEFLATE;
+
+        result = deflate(&writer->stream, finish ? Z_FINISH : Z_NO_FLUSH);
+        if(result == Z_STREAM_ERROR)
+            return panic("failed to deflate");
+
+        if(WRITER_DEFLATE - writer->stream.avail_out && writer_output(writer, writer->deflate, WRITER_DEFLATE - writer->stream.avail_out))
+            return panic("failed to output writer object");
+    } while(finish ? result != Z_STREAM_END : writer->stream.avail_in > 0);
+
+    return 0;
+}
+#endif
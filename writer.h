@@ -0,0 +1,36 @@
+#ifndef writer_h
+#define writer_h
+
+#include "panic.h"
+
+#ifdef WRITER_ZSTD
+#include <zstd.h>
+#define WRITER_EXTENSION ".zst"
+#else
+#include <zlib.h>
+#define WRITER_EXTENSION ".gz"
+#endif
+
+#define WRITER_CHUNK 67108864
+#define WRITER_DEFLATE 1048576
+
+struct writer {
+    int fd;
+    char * map;
+    size_t base;
+    size_t size;
+    size_t offset;
+    int level;
+    char * deflate;
+#ifdef WRITER_ZSTD
+    ZSTD_CCtx * stream;
+#else
+    z_stream stream;
+#endif
+};
+
+int writer_open(struct writer *, char *, int);
+int writer_close(struct writer *);
+int writer_write(struct writer *, char *, size_t);
+
+#endif
@@ -78,16 +78,14 @@ void yaml_destroy(struct yaml * yaml) {
 int yaml_parse(struct yaml * yaml, struct tag_node * root, const char * path, yaml_cb cb, void * arg) {
     int status = 0;
 
-    FILE * file;
-
-    file = fopen(path, "r");
-    if(!file) {
+    yaml->file = input_open(path);
+    if(!yaml->file) {
         status = panic("failed to open %s", path);
     } else {
         if(tag_load(&yaml->tag, root)) {
             status = panic("failed to load tag object");
         } else {
-            yamlrestart(file, yaml->scanner);
+            yamlrestart(NULL, yaml->scanner);
             yaml->iter = yaml->tag.root;
             yaml->next = NULL;
             yaml->cb = cb;
@@ -106,7 +104,7 @@ int yaml_parse(struct yaml * yaml, struct tag_node * root, const char * path, ya
                 status = panic("failed to document yaml object");
         }
 
-        fclose(file);
+        input_close(yaml->file);
     }
 
     return status;
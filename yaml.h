@@ -2,6 +2,7 @@
 #define yaml_h
 
 #include "tag.h"
+#include "input.h"
 
 enum yaml_event {
     yaml_list_start = 1,
@@ -38,6 +39,7 @@ enum yaml_token {
 };
 
 struct yaml {
+    gzFile file;
     struct yaml_node * stack;
     struct yaml_buffer * buffer;
     struct tag tag;